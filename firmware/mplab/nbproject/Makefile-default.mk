@@ -45,17 +45,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/main.c ../src/PAL_library.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/main.c ../src/PAL_library.c ../src/ACQ_library.c ../src/FREQ_library.c ../src/MEAS_library.c ../src/FMT_library.c ../src/PAL_assets.c ../src/PROF_library.c ../src/EXP_library.c ../src/DEEP_library.c ../src/INTERP_library.c ../src/INTERP_table.c ../src/AD_library.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1360937237/main.p1 ${OBJECTDIR}/_ext/1360937237/PAL_library.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1360937237/main.p1.d ${OBJECTDIR}/_ext/1360937237/PAL_library.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1360937237/main.p1 ${OBJECTDIR}/_ext/1360937237/PAL_library.p1 ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1 ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1 ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1 ${OBJECTDIR}/_ext/1360937237/FMT_library.p1 ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1 ${OBJECTDIR}/_ext/1360937237/PROF_library.p1 ${OBJECTDIR}/_ext/1360937237/EXP_library.p1 ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1 ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1 ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1 ${OBJECTDIR}/_ext/1360937237/AD_library.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1360937237/main.p1.d ${OBJECTDIR}/_ext/1360937237/PAL_library.p1.d ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1.d ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1.d ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1.d ${OBJECTDIR}/_ext/1360937237/FMT_library.p1.d ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1.d ${OBJECTDIR}/_ext/1360937237/PROF_library.p1.d ${OBJECTDIR}/_ext/1360937237/EXP_library.p1.d ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1.d ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1.d ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1.d ${OBJECTDIR}/_ext/1360937237/AD_library.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1360937237/main.p1 ${OBJECTDIR}/_ext/1360937237/PAL_library.p1
+OBJECTFILES=${OBJECTDIR}/_ext/1360937237/main.p1 ${OBJECTDIR}/_ext/1360937237/PAL_library.p1 ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1 ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1 ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1 ${OBJECTDIR}/_ext/1360937237/FMT_library.p1 ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1 ${OBJECTDIR}/_ext/1360937237/PROF_library.p1 ${OBJECTDIR}/_ext/1360937237/EXP_library.p1 ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1 ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1 ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1 ${OBJECTDIR}/_ext/1360937237/AD_library.p1
 
 # Source Files
-SOURCEFILES=../src/main.c ../src/PAL_library.c
+SOURCEFILES=../src/main.c ../src/PAL_library.c ../src/ACQ_library.c ../src/FREQ_library.c ../src/MEAS_library.c ../src/FMT_library.c ../src/PAL_assets.c ../src/PROF_library.c ../src/EXP_library.c ../src/DEEP_library.c ../src/INTERP_library.c ../src/INTERP_table.c ../src/AD_library.c
 
 
 CFLAGS=
@@ -97,6 +97,94 @@ ${OBJECTDIR}/_ext/1360937237/PAL_library.p1: ../src/PAL_library.c  nbproject/Mak
 	@-${MV} ${OBJECTDIR}/_ext/1360937237/PAL_library.d ${OBJECTDIR}/_ext/1360937237/PAL_library.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/PAL_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360937237/ACQ_library.p1: ../src/ACQ_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/ACQ_library.p1  ../src/ACQ_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/ACQ_library.d ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/FREQ_library.p1: ../src/FREQ_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/FREQ_library.p1  ../src/FREQ_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/FREQ_library.d ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/MEAS_library.p1: ../src/MEAS_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/MEAS_library.p1  ../src/MEAS_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/MEAS_library.d ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/FMT_library.p1: ../src/FMT_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FMT_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FMT_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/FMT_library.p1  ../src/FMT_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/FMT_library.d ${OBJECTDIR}/_ext/1360937237/FMT_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/FMT_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/PAL_assets.p1: ../src/PAL_assets.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/PAL_assets.p1  ../src/PAL_assets.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/PAL_assets.d ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/PROF_library.p1: ../src/PROF_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PROF_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PROF_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/PROF_library.p1  ../src/PROF_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/PROF_library.d ${OBJECTDIR}/_ext/1360937237/PROF_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/PROF_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/EXP_library.p1: ../src/EXP_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/EXP_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/EXP_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/EXP_library.p1  ../src/EXP_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/EXP_library.d ${OBJECTDIR}/_ext/1360937237/EXP_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/EXP_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/DEEP_library.p1: ../src/DEEP_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/DEEP_library.p1  ../src/DEEP_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/DEEP_library.d ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/INTERP_library.p1: ../src/INTERP_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/INTERP_library.p1  ../src/INTERP_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/INTERP_library.d ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/INTERP_table.p1: ../src/INTERP_table.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/INTERP_table.p1  ../src/INTERP_table.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/INTERP_table.d ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/AD_library.p1: ../src/AD_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/AD_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/AD_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=none  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/AD_library.p1  ../src/AD_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/AD_library.d ${OBJECTDIR}/_ext/1360937237/AD_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/AD_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 else
 ${OBJECTDIR}/_ext/1360937237/main.p1: ../src/main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
@@ -114,6 +202,94 @@ ${OBJECTDIR}/_ext/1360937237/PAL_library.p1: ../src/PAL_library.c  nbproject/Mak
 	@-${MV} ${OBJECTDIR}/_ext/1360937237/PAL_library.d ${OBJECTDIR}/_ext/1360937237/PAL_library.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/PAL_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/_ext/1360937237/ACQ_library.p1: ../src/ACQ_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/ACQ_library.p1  ../src/ACQ_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/ACQ_library.d ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/ACQ_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/FREQ_library.p1: ../src/FREQ_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/FREQ_library.p1  ../src/FREQ_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/FREQ_library.d ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/FREQ_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/MEAS_library.p1: ../src/MEAS_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/MEAS_library.p1  ../src/MEAS_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/MEAS_library.d ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/MEAS_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/FMT_library.p1: ../src/FMT_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FMT_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/FMT_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/FMT_library.p1  ../src/FMT_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/FMT_library.d ${OBJECTDIR}/_ext/1360937237/FMT_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/FMT_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/PAL_assets.p1: ../src/PAL_assets.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/PAL_assets.p1  ../src/PAL_assets.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/PAL_assets.d ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/PAL_assets.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/PROF_library.p1: ../src/PROF_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PROF_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/PROF_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/PROF_library.p1  ../src/PROF_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/PROF_library.d ${OBJECTDIR}/_ext/1360937237/PROF_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/PROF_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/EXP_library.p1: ../src/EXP_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/EXP_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/EXP_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/EXP_library.p1  ../src/EXP_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/EXP_library.d ${OBJECTDIR}/_ext/1360937237/EXP_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/EXP_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/DEEP_library.p1: ../src/DEEP_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/DEEP_library.p1  ../src/DEEP_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/DEEP_library.d ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/DEEP_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/INTERP_library.p1: ../src/INTERP_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/INTERP_library.p1  ../src/INTERP_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/INTERP_library.d ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/INTERP_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/INTERP_table.p1: ../src/INTERP_table.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/INTERP_table.p1  ../src/INTERP_table.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/INTERP_table.d ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/INTERP_table.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/_ext/1360937237/AD_library.p1: ../src/AD_library.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/AD_library.p1.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/AD_library.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --emi=wordwrite --opt=default,+asm,+asmfile,-speed,+space,-debug --addrqual=ignore --mode=free -P -N255 --warn=-3 --asmlist --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,-download,+config,+clib,-plib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/_ext/1360937237/AD_library.p1  ../src/AD_library.c 
+	@-${MV} ${OBJECTDIR}/_ext/1360937237/AD_library.d ${OBJECTDIR}/_ext/1360937237/AD_library.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/_ext/1360937237/AD_library.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -0,0 +1,709 @@
+/*
+ * file         : ACQ_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      hardware paced sample acquisition for PIC18 MCU
+ *      CCP2 in special event trigger mode resets TIMER 3 and starts a new A/D
+ *      conversion every period, so the sample clock does not depend on what
+ *      the main loop is doing. The A/D complete interrupt stores each sample
+ *      in a circular buffer of ACQ_DEPTH bytes ; when a full record has been
+ *      captured, the buffer is frozen until the draw code releases it.
+ *
+ *      the trigger is evaluated on each incoming sample : the circular buffer
+ *      keeps the pre-trigger samples, and once the trigger fires only the
+ *      post-trigger samples are counted down. Falling edges are compared on
+ *      complemented samples, so both slopes share the same two compares.
+ *
+ *      equivalent time sampling (ETS) mode builds one record of a repetitive
+ *      signal over ACQ_DEPTH trigger events : the rising edge on RC2 is
+ *      captured by CCP1 (TIMER 1), TIMER 3 is then loaded with the time
+ *      elapsed since the edge, and CCP2 starts the conversion of slot k
+ *      exactly delay + k * step cycles after the edge. The equivalent
+ *      sample rate is up to one sample per instruction cycle.
+ *
+ *      the timebase table programs the sample clock : fast timebases use ETS,
+ *      slow ones sample faster than one sample per column and decimate on the
+ *      fly (keep first sample, min/max pair, or average of the column).
+ *      In sparse mode, the fast timebases that are no more than
+ *      ACQ_SPARSE_SHIFT_MAX octaves away from real time sampling are sampled
+ *      in real time instead of ETS : one sample every 2^ACQ_sparseShift
+ *      columns, the columns in between are interpolated by the caller
+ *      (INTERP_library). Unlike ETS, this works on single shot signals.
+ *
+ *      each stored sample also updates the record statistics : sum and sum of
+ *      squares slide with the circular buffer (the overwritten sample is
+ *      removed), so they are exact for the frozen record ; min and max cover
+ *      all samples since the record was armed.
+ *      it is also appended to the deep record (DEEP_library), which keeps
+ *      several screens of samples, compressed.
+ *
+ *      the converter is driven by AD_library : automatic acquisition time,
+ *      left justified result, the sample is ADRESH alone.
+ *
+ *      the acquisition runs on the LOW priority interrupt, so that it never
+ *      delays the PAL video interrupt. It must be called by user like this :
+ *      void interrupt_low() { AD_ISR() ; ACQ_ISR() ; }
+ *
+ * target devices :
+ *      PIC18F4550 @ 32 Mhz (8 Mhz instruction clock)
+ */
+
+#include        "INT_types.h"
+#include        "ACQ_library.h"
+#include        "AD_library.h"
+#include        "DEEP_library.h"
+#include        "PROF_library.h"
+
+/*
+ * a timebase table entry
+ */
+typedef struct
+        {
+        unsigned int    period ;        // real time sample period (cycles), 0 for ETS
+        unsigned char   step ;          // ETS equivalent sample period (cycles)
+        unsigned char   shift ;         // log2 of samples per column
+        } ACQ_TIMEBASE ;
+
+/*****************
+ * ROM tables
+ *****************/
+/*
+ * column time = step or period << shift, in 125 ns instruction cycles
+ * real time periods are kept >= 500 cycles (about one PAL video line),
+ * so that a sample is never overwritten while PAL_ISR is running
+ */
+const ACQ_TIMEBASE      ACQ_timebase[ACQ_TB_COUNT] =
+        {
+        {     0,   1, 0 },      // 2 us/div
+        {     0,   2, 0 },      // 4 us/div
+        {     0,   5, 0 },      // 10 us/div
+        {     0,  10, 0 },      // 20 us/div
+        {     0,  20, 0 },      // 40 us/div
+        {     0,  50, 0 },      // 100 us/div
+        {     0, 100, 0 },      // 200 us/div
+        {     0, 200, 0 },      // 400 us/div
+        {   500,   0, 0 },      // 1 ms/div
+        {   500,   0, 1 },      // 2 ms/div
+        {   500,   0, 2 },      // 4 ms/div
+        {   625,   0, 3 },      // 10 ms/div
+        {   625,   0, 4 },      // 20 ms/div
+        {   625,   0, 5 },      // 40 ms/div
+        {  3125,   0, 4 },      // 100 ms/div
+        {  3125,   0, 5 },      // 200 ms/div
+        {  3125,   0, 6 },      // 400 ms/div
+        { 15625,   0, 5 }       // 1 s/div
+        } ;
+
+/*
+ * store sample s at head and in the deep record, update record statistics
+ * PRODH:PRODL hardware multiplier makes the squares cheap
+ */
+#define ACQ_STORE(s)    {\
+                        unsigned char old ;\
+                        old = ACQ_buffer[ACQ_head] ;\
+                        ACQ_buffer[ACQ_head] = s ;\
+                        ACQ_head = (ACQ_head + 1) & ACQ_MASK ;\
+                        ACQ_sum += s ;\
+                        ACQ_sum -= old ;\
+                        ACQ_sumSq += (unsigned int)s * s ;\
+                        ACQ_sumSq -= (unsigned int)old * old ;\
+                        if(s < ACQ_min) ACQ_min = s ;\
+                        if(s > ACQ_max) ACQ_max = s ;\
+                        DEEP_push(s) ;\
+                        }
+
+/***************
+ * RAM variables
+ ***************/
+unsigned char   ACQ_buffer[ACQ_DEPTH] ;         // circular sample buffer (8 bits samples)
+volatile unsigned char   ACQ_state = ACQ_STATE_STOP ;   // acquisition state
+unsigned char   ACQ_channel = 0 ;               // analog channel sampled
+unsigned char   ACQ_head = 0 ;                  // next write index in buffer
+unsigned int    ACQ_count = 0 ;                 // samples left in HOLD or POST state
+unsigned int    ACQ_autoCtr = 0 ;               // samples left before free run, 0 = never
+unsigned char   ACQ_armed = 0 ;                 // signal went through the hysteresis band
+unsigned char   ACQ_trigMode = ACQ_TRIG_AUTO ;  // AUTO, NORMAL or SINGLE
+unsigned char   ACQ_trigSlope = ACQ_TRIG_RISING ;       // sample xor mask
+unsigned char   ACQ_trigLevel = 0x80 ;          // trigger level, slope corrected
+unsigned char   ACQ_trigArm = 0x7c ;            // arming level, slope corrected
+unsigned char   ACQ_pre = ACQ_DEPTH / 2 ;       // pre-trigger samples in record
+unsigned int    ACQ_holdoff = 0 ;               // minimum samples between records
+unsigned int    ACQ_period = ACQ_PERIOD_DEFAULT ;       // real time sample period
+unsigned char   ACQ_ets = 0 ;                   // equivalent time sampling mode flag
+unsigned int    ACQ_etsDelay = ACQ_ETS_DELAY_MIN ;      // trigger to first slot delay (cycles)
+unsigned char   ACQ_etsStep = 1 ;               // equivalent sample period (cycles)
+unsigned int    ACQ_etsOffset = 0 ;             // trigger to current slot delay (cycles)
+unsigned char   ACQ_decimMode = ACQ_DECIM_SAMPLE ;      // decimation kernel
+unsigned char   ACQ_decimUser = ACQ_DECIM_SAMPLE ;      // kernel given to ACQ_setDecimation
+unsigned char   ACQ_decimShift = 0 ;            // log2 of samples per column
+unsigned char   ACQ_sparse = 0 ;                // fast timebases in real time flag
+unsigned char   ACQ_sparseShift = 0 ;           // log2 of columns per sample
+unsigned char   ACQ_decim = 1 ;                 // samples per pushed value (pair in peak mode)
+unsigned char   ACQ_decimCtr = 1 ;              // samples left in current column
+unsigned char   ACQ_decimMin = 0xff ;           // peak mode accumulators
+unsigned char   ACQ_decimMax = 0 ;
+unsigned int    ACQ_decimSum = 0 ;              // average mode accumulator, first sample in sample mode
+unsigned int    ACQ_sum = 0 ;                   // sum of samples in buffer
+unsigned long   ACQ_sumSq = 0 ;                 // sum of squared samples in buffer
+unsigned char   ACQ_min = 0xff ;                // smallest sample since armed
+unsigned char   ACQ_max = 0 ;                   // largest sample since armed
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * ACQ_push : store one (decimated) sample and run the trigger
+ * called by ACQ_ISR only
+ ***********************************/
+static void     ACQ_push(unsigned char s)
+        {
+        if(ACQ_state == ACQ_STATE_DONE) return ;        // second value of a min/max pair
+
+        ACQ_STORE(s) ;
+
+        switch(ACQ_state)
+                {
+                case ACQ_STATE_HOLD:                    // pre-trigger buffer and holdoff
+                        if(--ACQ_count == 0)
+                                {
+                                ACQ_armed = 0 ;
+                                ACQ_autoCtr = (ACQ_trigMode == ACQ_TRIG_AUTO) ? ACQ_AUTO_TIMEOUT : 0 ;
+                                ACQ_state = ACQ_STATE_ARM ;
+                                }
+                        break ;
+
+                case ACQ_STATE_ARM:                     // waiting for trigger
+                        s ^= ACQ_trigSlope ;
+                        if(ACQ_armed)
+                                {
+                                if(s >= ACQ_trigLevel) ACQ_autoCtr = 1 ;        // fire now
+                                }
+                        else if(s < ACQ_trigArm)
+                                {
+                                ACQ_armed = 1 ;         // below hysteresis band : next crossing fires
+                                }
+
+                        if(ACQ_autoCtr)
+                                {
+                                if(--ACQ_autoCtr == 0)  // triggered, or auto timeout
+                                        {
+                                        ACQ_count = ACQ_DEPTH - 1 - ACQ_pre ;
+                                        ACQ_state = ACQ_count ? ACQ_STATE_POST : ACQ_STATE_DONE ;
+                                        }
+                                }
+                        break ;
+
+                default:                                // post-trigger samples
+                        if(--ACQ_count == 0)
+                                {
+                                ACQ_state = ACQ_STATE_DONE ;    // freeze buffer until released
+                                }
+                        break ;
+                }
+        }
+
+/************************************
+ * ACQ_edge : ETS trigger edge
+ * This function MUST be called by user in the interrupt_low() routine
+ * when CCP1 has captured an edge on RC2, before clearing PIR1.CCP1IF.
+ * CCP1 is shared with FREQ_library.
+ ***********************************/
+void    ACQ_edge()
+        {
+        INT_U16         now, elapsed ;
+
+        if(!ACQ_ets) return ;
+
+        /*
+         * TIMER 3 restarts from the edge time,
+         * so that CCP2 fires ACQ_etsOffset cycles after the edge
+         */
+        now = TMR1L ;                           // reading TMR1L latches TMR1H
+        now |= (INT_U16)(TMR1H << 8) ;
+        elapsed = (INT_U16)(now - (((INT_U16)CCPR1H << 8) | CCPR1L) + ACQ_ETS_LATENCY) ;     // cycles since the edge
+
+        if((ACQ_state == ACQ_STATE_ARM) && (elapsed < ACQ_etsOffset - ACQ_ETS_MARGIN))
+                {
+                TMR3H = elapsed >> 8 ;          // TMR3H is written with TMR3L
+                TMR3L = elapsed ;
+                CCPR2H = ACQ_etsOffset >> 8 ;
+                CCPR2L = ACQ_etsOffset ;
+                CCP2CON = 0b00001011 ;          // one special event trigger
+
+                /*
+                 * PAL_ISR may have run since the first read : TIMER 3 is then
+                 * late by the time it took, the slot is dropped and the next
+                 * edge is waited for. A conversion it has already started is
+                 * ignored by ACQ_ISR, the state is still ARM.
+                 */
+                elapsed = TMR1L ;
+                elapsed |= (INT_U16)(TMR1H << 8) ;
+                if((INT_U16)(elapsed - now) > ACQ_ETS_WINDOW)
+                        {
+                        CCP2CON = 0 ;
+                        return ;
+                        }
+
+                ACQ_state = ACQ_STATE_POST ;
+                }
+        // else too late for this slot : wait for next edge
+        }
+
+/************************************
+ * Interrupt service routine
+ * This function MUST be included by user in the interrupt_low() routine
+ * one call stores one sample
+ ***********************************/
+void    ACQ_ISR()
+        {
+        if(PIR1.ADIF)
+                {
+                unsigned char   s ;
+
+                PROF_EVENT(PROF_SAMPLES) ;
+
+                s = AD_RESULT8 ;                        // 8 MSB of the left justified result
+
+                PIR1.ADIF = 0 ;                         // clear A/D interrupt flag
+
+                if(ACQ_state == ACQ_STATE_STOP) return ;
+                if(ACQ_state == ACQ_STATE_DONE) return ;
+
+                if(ACQ_ets)
+                        {
+                        if(ACQ_state != ACQ_STATE_POST) return ;        // not a scheduled conversion
+
+                        CCP2CON = 0 ;                   // no more conversion until next edge
+                        ACQ_STORE(s) ;                  // slot k is sample k
+                        ACQ_etsOffset += ACQ_etsStep ;
+                        ACQ_state = ACQ_head ? ACQ_STATE_ARM : ACQ_STATE_DONE ;
+                        return ;
+                        }
+
+                /*
+                 * decimation : each kernel works on the incoming sample only,
+                 * one value (min/max pair in peak mode) is pushed every ACQ_decim samples
+                 */
+                switch(ACQ_decimMode)
+                        {
+                        case ACQ_DECIM_PEAK:
+                                if(s < ACQ_decimMin) ACQ_decimMin = s ;
+                                if(s > ACQ_decimMax) ACQ_decimMax = s ;
+                                break ;
+                        case ACQ_DECIM_AVERAGE:
+                                ACQ_decimSum += s ;
+                                break ;
+                        default:
+                                if(ACQ_decimCtr == ACQ_decim) ACQ_decimSum = s ;     // keep first sample
+                                break ;
+                        }
+
+                if(--ACQ_decimCtr) return ;
+                ACQ_decimCtr = ACQ_decim ;
+
+                switch(ACQ_decimMode)
+                        {
+                        case ACQ_DECIM_PEAK:
+                                ACQ_push(ACQ_decimMin) ;        // one pair covers two columns
+                                ACQ_push(ACQ_decimMax) ;
+                                ACQ_decimMin = 0xff ;
+                                ACQ_decimMax = 0 ;
+                                break ;
+                        case ACQ_DECIM_AVERAGE:
+                                ACQ_push((unsigned char)(ACQ_decimSum >> ACQ_decimShift)) ;
+                                ACQ_decimSum = 0 ;
+                                break ;
+                        default:
+                                ACQ_push((unsigned char)ACQ_decimSum) ;
+                                break ;
+                        }
+                }
+        }
+
+/************************************************************
+ * ACQ_init : acquisition initialization
+ * parameters :
+ *      ch : analog channel to sample
+ * returns :
+ *      nothing
+ * requires :
+ *      analog pins must have been configured in ADCON1
+ * notes :
+ *      this function takes control of the A/D converter, TIMER 3, CCP2
+ *      and switches interrupts to priority mode (TIMER 0 stays high priority)
+ */
+void    ACQ_init(unsigned char ch)
+        {
+        ACQ_state = ACQ_STATE_STOP ;
+
+        ACQ_channel = ch ;
+        AD_init(AD_ACQT_4TAD, AD_ADCS_FOSC32) ; // left justified, 4 TAD acquisition, Fosc/32
+        AD_select(ACQ_channel) ;
+
+        T1CON = 0b10000001 ;            // 16 bits, prescaler = 1, free running, TIMER 1 is CCP1 clock source
+        T3CON = 0b10001000 ;            // 16 bits, prescaler = 1, TIMER 3 is CCP2 clock source, stopped
+        CCP2CON = 0b00001011 ;          // compare, special event trigger : reset TIMER 3 and start A/D
+
+        ACQ_setPeriod(ACQ_PERIOD_DEFAULT) ;
+
+        RCON.IPEN = 1 ;                 // enable interrupt priorities
+        INTCON2.TMR0IP = 1 ;            // TIMER 0 (PAL video) is high priority
+        CCP1CON = 0b00000101 ;          // capture every rising edge on RC2
+        IPR1.CCP1IP = 0 ;               // ETS trigger capture is low priority
+        INTCON.GIEL = 1 ;               // enable low priority interrupts
+        }
+
+/**********************************************
+ * ACQ_control : start/stop acquisition
+ * parameters :
+ *      st : ACQ_CNTL_START or ACQ_CNTL_STOP
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      starting discards the current record
+ */
+void    ACQ_control(unsigned char st)
+        {
+        if(st)
+                {
+                AD_select(ACQ_channel) ;        // an AD_sequence may have moved it
+                ACQ_arm() ;
+                TMR3H = 0 ;
+                TMR3L = 0 ;
+                T3CON.TMR3ON = 1 ;      // start sample clock
+                INTCON.GIEH = 1 ;       // enable global interrupts
+                }
+        else
+                {
+                T3CON.TMR3ON = 0 ;      // stop sample clock
+                ACQ_state = ACQ_STATE_STOP ;
+                }
+        }
+
+/**********************************************
+ * ACQ_setPeriod : set sample period
+ * parameters :
+ *      period : sample period in instruction cycles
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      period is clipped to ACQ_PERIOD_MIN, the A/D acquisition + conversion time
+ */
+void    ACQ_setPeriod(unsigned int period)
+        {
+        if(period < ACQ_PERIOD_MIN) period = ACQ_PERIOD_MIN ;
+
+        ACQ_period = period ;
+        if(ACQ_ets) return ;            // CCPR2 is scheduled per trigger in ETS mode
+
+        CCPR2H = period >> 8 ;          // TIMER 3 is reset on match
+        CCPR2L = period ;
+        }
+
+/**********************************************
+ * ACQ_setETS : equivalent time sampling mode
+ * parameters :
+ *      on : 1 for ETS mode, 0 for real time sampling
+ *      delay : delay from trigger edge to first sample, in instruction cycles
+ *      step : equivalent sample period, in instruction cycles
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ *      a conditioned (comparator or schmitt trigger) copy of the input on RC2/CCP1
+ * notes :
+ *      the signal MUST be repetitive, one record needs at least ACQ_DEPTH trigger edges.
+ *      delay is clipped to ACQ_ETS_DELAY_MIN, because the conversion must be
+ *      scheduled after the interrupt latency (up to one PAL video line),
+ *      so the record does not start on the trigger edge itself.
+ *      the trigger is the rising edge of RC2, its level is set by the external comparator,
+ *      FREQ_library may prescale the captures, which only makes ETS triggers sparser
+ */
+void    ACQ_setETS(unsigned char on, unsigned int delay, unsigned char step)
+        {
+        if(delay < ACQ_ETS_DELAY_MIN) delay = ACQ_ETS_DELAY_MIN ;
+        if(step == 0) step = 1 ;
+
+        INTCON.GIEL = 0 ;
+
+        ACQ_ets = on ;
+        ACQ_etsDelay = delay ;
+        ACQ_etsStep = step ;
+
+        if(on)
+                {
+                PIE1.CCP1IE = 1 ;       // enable edge capture interrupt
+                }
+        else
+                {
+                CCP2CON = 0b00001011 ;  // back to periodic special event trigger
+                ACQ_setPeriod(ACQ_period) ;
+                }
+
+        INTCON.GIEL = 1 ;
+
+        ACQ_arm() ;
+        }
+
+/**********************************************
+ * ACQ_setSparse : sparse records at the fast timebases
+ * parameters :
+ *      on : 1 to sample the fast timebases in real time, 0 for ETS
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      takes effect on next ACQ_setTimebase,
+ *      the timebases that would need more than 2^ACQ_SPARSE_SHIFT_MAX columns
+ *      per sample still use ETS
+ */
+void    ACQ_setSparse(unsigned char on)
+        {
+        ACQ_sparse = on ;
+        }
+
+/**********************************************
+ * ACQ_setTrigger : set trigger condition
+ * parameters :
+ *      mode : ACQ_TRIG_AUTO, ACQ_TRIG_NORMAL or ACQ_TRIG_SINGLE
+ *      slope : ACQ_TRIG_RISING or ACQ_TRIG_FALLING
+ *      level : trigger level, in sample units [0;255]
+ *      hyst : hysteresis, the signal must cross level - hyst before level
+ *              (level + hyst for falling slope) to trigger
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      takes effect on next record
+ */
+void    ACQ_setTrigger(unsigned char mode, unsigned char slope, unsigned char level, unsigned char hyst)
+        {
+        level ^= slope ;        // falling slope : work on complemented samples
+
+        INTCON.GIEL = 0 ;
+        ACQ_trigMode = mode ;
+        ACQ_trigSlope = slope ;
+        ACQ_trigLevel = level ;
+        ACQ_trigArm = (level > hyst) ? level - hyst : 1 ;
+        INTCON.GIEL = 1 ;
+        }
+
+/**********************************************
+ * ACQ_setPretrigger : set pre-trigger size
+ * parameters :
+ *      percent : part of the record before the trigger point [0;100]
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      takes effect on next record
+ */
+void    ACQ_setPretrigger(unsigned char percent)
+        {
+        unsigned int    pre ;
+
+        pre = (unsigned int)percent * ACQ_DEPTH / 100 ;
+        if(pre > ACQ_DEPTH - 1) pre = ACQ_DEPTH - 1 ;   // trigger sample is always in record
+
+        ACQ_pre = (unsigned char)pre ;
+        }
+
+/**********************************************
+ * ACQ_setHoldoff : set trigger holdoff
+ * parameters :
+ *      holdoff : number of samples after ACQ_release before the trigger is armed
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      holdoff shorter than the pre-trigger size has no effect
+ */
+void    ACQ_setHoldoff(unsigned int holdoff)
+        {
+        ACQ_holdoff = holdoff ;
+        }
+
+/**********************************************
+ * ACQ_setTimebase : select a timebase
+ * parameters :
+ *      tb : timebase index, ACQ_TB_2US to ACQ_TB_1S
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      selects ETS or real time sampling, and restarts the record,
+ *      ACQ_sparseShift gives the columns per sample of a sparse record
+ */
+void    ACQ_setTimebase(unsigned char tb)
+        {
+        unsigned int    period ;
+        unsigned char   shift ;
+
+        if(tb >= ACQ_TB_COUNT) tb = ACQ_TB_COUNT - 1 ;
+
+        ACQ_decimShift = ACQ_timebase[tb].shift ;
+
+        period = ACQ_timebase[tb].period ;
+        shift = 0 ;
+        if(!period && ACQ_sparse)
+                {
+                /*
+                 * shortest real time period that is a power of 2 columns
+                 */
+                period = ACQ_timebase[tb].step ;
+                while((period < ACQ_PERIOD_REALTIME) && (shift <= ACQ_SPARSE_SHIFT_MAX))
+                        {
+                        period <<= 1 ;
+                        shift++ ;
+                        }
+                if(shift > ACQ_SPARSE_SHIFT_MAX) period = 0 ;   // too sparse
+                }
+
+        if(period)
+                {
+                ACQ_sparseShift = shift ;
+                ACQ_setPeriod(period) ;
+                ACQ_setDecimation(ACQ_decimUser) ;
+                ACQ_setETS(0, ACQ_ETS_DELAY_MIN, 1) ;
+                }
+        else
+                {
+                ACQ_sparseShift = 0 ;
+                ACQ_setETS(1, ACQ_ETS_DELAY_MIN, ACQ_timebase[tb].step) ;
+                }
+        }
+
+/**********************************************
+ * ACQ_setDecimation : select decimation kernel
+ * parameters :
+ *      mode : ACQ_DECIM_SAMPLE, ACQ_DECIM_PEAK or ACQ_DECIM_AVERAGE
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      in ACQ_DECIM_PEAK mode, the record is made of (min, max) pairs,
+ *      each pair covering two columns
+ *      no effect in ETS mode, and sparse records are not decimated : the
+ *      mode is kept for the next timebases
+ */
+void    ACQ_setDecimation(unsigned char mode)
+        {
+        INTCON.GIEL = 0 ;
+
+        ACQ_decimUser = mode ;
+        if(ACQ_sparseShift) mode = ACQ_DECIM_SAMPLE ;
+        ACQ_decimMode = mode ;
+        ACQ_decim = (mode == ACQ_DECIM_PEAK) ? 2 << ACQ_decimShift : 1 << ACQ_decimShift ;
+        ACQ_decimCtr = ACQ_decim ;
+        ACQ_decimMin = 0xff ;
+        ACQ_decimMax = 0 ;
+        ACQ_decimSum = 0 ;
+
+        INTCON.GIEL = 1 ;
+        }
+
+/**********************************************
+ * ACQ_arm : start a new record
+ * parameters :
+ *      none
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      this is the only way to get a new record in ACQ_TRIG_SINGLE mode
+ */
+void    ACQ_arm()
+        {
+        INTCON.GIEL = 0 ;               // ACQ_count is shared with ACQ_ISR
+
+        ACQ_min = 0xff ;
+        ACQ_max = 0 ;
+
+        if(ACQ_ets)
+                {
+                CCP2CON = 0 ;           // no conversion until first edge
+                ACQ_head = 0 ;          // record starts at slot 0
+                ACQ_etsOffset = ACQ_etsDelay ;
+                DEEP_clear(1) ;
+                ACQ_state = ACQ_STATE_ARM ;
+                }
+        else
+                {
+                ACQ_count = (ACQ_holdoff > ACQ_pre) ? ACQ_holdoff : ACQ_pre ;
+                if(ACQ_count == 0) ACQ_count = 1 ;
+                ACQ_decimCtr = ACQ_decim ;      // start on a column boundary
+                ACQ_decimMin = 0xff ;
+                ACQ_decimMax = 0 ;
+                ACQ_decimSum = 0 ;
+                DEEP_clear((ACQ_decimMode == ACQ_DECIM_PEAK) ? 2 : 1) ;
+                ACQ_state = ACQ_STATE_HOLD ;
+                }
+
+        INTCON.GIEL = 1 ;
+        }
+
+/**********************************************
+ * ACQ_ready : is a record complete ?
+ * parameters :
+ *      none
+ * returns :
+ *      1 if a record is complete, 0 otherwise
+ * requires :
+ *      ACQ_control must have been called
+ * notes :
+ *      none
+ */
+unsigned char   ACQ_ready()
+        {
+        return(ACQ_state == ACQ_STATE_DONE) ;
+        }
+
+/**********************************************
+ * ACQ_take : take a complete record
+ * parameters :
+ *      none
+ * returns :
+ *      index of the first (oldest) sample of the record in ACQ_buffer
+ * requires :
+ *      ACQ_ready must have returned 1
+ * notes :
+ *      the record stays frozen until ACQ_release is called,
+ *      read it with ACQ_SAMPLE(first, i), i in [0;ACQ_DEPTH-1]
+ */
+unsigned char   ACQ_take()
+        {
+        return(ACQ_head) ;      // buffer is full : oldest sample is the next one to be overwritten
+        }
+
+/**********************************************
+ * ACQ_release : release a record
+ * parameters :
+ *      none
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called
+ * notes :
+ *      acquisition of the next record starts immediately,
+ *      except in ACQ_TRIG_SINGLE mode where the record is kept until ACQ_arm
+ */
+void    ACQ_release()
+        {
+        if((ACQ_trigMode == ACQ_TRIG_SINGLE) && (ACQ_state == ACQ_STATE_DONE)) return ;
+
+        ACQ_arm() ;
+        }
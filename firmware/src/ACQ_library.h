@@ -0,0 +1,96 @@
+#define ACQ_DEPTH               128     // samples per record, one per screen column
+#define ACQ_MASK                (ACQ_DEPTH - 1)
+
+#define ACQ_PERIOD_MIN          160     // shortest sample period in instruction cycles (20 us)
+#define ACQ_PERIOD_DEFAULT      800     // default sample period in instruction cycles (100 us)
+#define ACQ_PERIOD_REALTIME     500     // shortest real time period of the timebases (cycles)
+
+#define ACQ_STATE_STOP          0       // sampling stopped
+#define ACQ_STATE_HOLD          1       // filling pre-trigger buffer, holdoff
+#define ACQ_STATE_ARM           2       // waiting for trigger
+#define ACQ_STATE_POST          3       // capturing post-trigger samples
+#define ACQ_STATE_DONE          4       // record is complete
+
+#define ACQ_TRIG_AUTO           0       // trigger, or free run after ACQ_AUTO_TIMEOUT samples
+#define ACQ_TRIG_NORMAL         1       // wait for trigger
+#define ACQ_TRIG_SINGLE         2       // one record, then hold until ACQ_arm()
+
+#define ACQ_TRIG_RISING         0x00    // trigger on rising edge
+#define ACQ_TRIG_FALLING        0xff    // trigger on falling edge
+
+#define ACQ_ETS_DELAY_MIN       640     // shortest trigger to sample delay in ETS mode (80 us)
+#define ACQ_ETS_LATENCY         12      // cycles from TMR1 read to TMR3 write in ACQ_ISR
+#define ACQ_ETS_MARGIN          16      // cycles needed to schedule a conversion
+#define ACQ_ETS_WINDOW          64      // longest TMR1 read to TMR1 read in ACQ_edge when not preempted
+
+#define ACQ_AUTO_TIMEOUT        (ACQ_DEPTH * 4) // samples without trigger before free run
+
+#define ACQ_DIV                 16      // columns per horizontal division
+
+#define ACQ_DECIM_SAMPLE        0       // keep first sample of each column
+#define ACQ_DECIM_PEAK          1       // min/max pair every two columns
+#define ACQ_DECIM_AVERAGE       2       // boxcar average of each column
+
+#define ACQ_SPARSE_SHIFT_MAX    4       // sparse records : 16 columns per sample at most
+
+/*
+ * timebases, time per division (ACQ_DIV columns)
+ */
+#define ACQ_TB_2US              0
+#define ACQ_TB_4US              1
+#define ACQ_TB_10US             2
+#define ACQ_TB_20US             3
+#define ACQ_TB_40US             4
+#define ACQ_TB_100US            5
+#define ACQ_TB_200US            6
+#define ACQ_TB_400US            7
+#define ACQ_TB_1MS              8
+#define ACQ_TB_2MS              9
+#define ACQ_TB_4MS              10
+#define ACQ_TB_10MS             11
+#define ACQ_TB_20MS             12
+#define ACQ_TB_40MS             13
+#define ACQ_TB_100MS            14
+#define ACQ_TB_200MS            15
+#define ACQ_TB_400MS            16
+#define ACQ_TB_1S               17
+#define ACQ_TB_COUNT            18
+
+#define ACQ_CNTL_STOP           0
+#define ACQ_CNTL_START          1
+
+/*
+ * sample i of the record returned by ACQ_take()
+ */
+#define ACQ_SAMPLE(first, i)    ACQ_buffer[((first) + (i)) & ACQ_MASK]
+
+extern  unsigned char   ACQ_buffer[] ;
+extern  volatile unsigned char   ACQ_state ;
+extern  unsigned int    ACQ_sum ;
+extern  unsigned long   ACQ_sumSq ;
+extern  unsigned char   ACQ_min ;
+extern  unsigned char   ACQ_max ;
+extern  unsigned int    ACQ_period ;
+extern  unsigned char   ACQ_ets ;
+extern  unsigned char   ACQ_etsStep ;
+extern  unsigned char   ACQ_pre ;
+extern  unsigned char   ACQ_decimMode ;
+extern  unsigned char   ACQ_decimShift ;
+extern  unsigned char   ACQ_sparseShift ;
+
+void    ACQ_ISR() ;
+void    ACQ_edge() ;
+void    ACQ_init(unsigned char ch) ;
+void    ACQ_control(unsigned char st) ;
+void    ACQ_setPeriod(unsigned int period) ;
+void    ACQ_setTrigger(unsigned char mode, unsigned char slope, unsigned char level, unsigned char hyst) ;
+void    ACQ_setPretrigger(unsigned char percent) ;
+void    ACQ_setHoldoff(unsigned int holdoff) ;
+void    ACQ_setETS(unsigned char on, unsigned int delay, unsigned char step) ;
+void    ACQ_setSparse(unsigned char on) ;
+void    ACQ_setTimebase(unsigned char tb) ;
+void    ACQ_setDecimation(unsigned char mode) ;
+void    ACQ_arm() ;
+unsigned char   ACQ_ready() ;
+unsigned char   ACQ_take() ;
+void    ACQ_release() ;
@@ -0,0 +1,197 @@
+/*
+ * file         : AD_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      non blocking A/D converter driver for PIC18 MCU
+ *      unlike the mikroC ADC_Read, which waits for the acquisition time and
+ *      then spins on GO/DONE, the converter is set up once with an automatic
+ *      acquisition time (ADCON2 ACQT) : setting GO (or the CCP2 special
+ *      event) samples, then converts, with no software delay, and the end
+ *      of the conversion is signalled by the GO/DONE flag or by the A/D
+ *      interrupt.
+ *
+ *      the result is left justified : the 8 MSB are ADRESH alone, one read
+ *      and no shift, the fast path of the sample interrupt. The 10 bits are
+ *      still available with AD_RESULT10.
+ *
+ *      the selected channel is cached, selecting it again writes nothing,
+ *      so that sequences and users of a single channel do not reconfigure
+ *      the converter before each conversion.
+ *
+ *      a sequence converts up to AD_SEQ_MAX channels one after the other
+ *      from the A/D interrupt, the 8 MSB of channel i are in AD_results[i].
+ *      ACQ_library owns the converter while it samples : sequences must be
+ *      run while the acquisition is stopped, it selects its channel again
+ *      when it is started. AD_ISR must be called by user before ACQ_ISR :
+ *      void interrupt_low() { AD_ISR() ; ACQ_ISR() ; }
+ *
+ * target devices :
+ *      PIC18F4550 @ 32 Mhz (8 Mhz instruction clock)
+ */
+
+#include        "AD_library.h"
+
+/***************
+ * RAM variables
+ ***************/
+unsigned char   AD_channel = 0xff ;             // selected channel, 0xff before AD_init
+unsigned char   AD_seq[AD_SEQ_MAX] ;            // channels of the sequence
+unsigned char   AD_seqLength = 0 ;              // channels in the sequence
+unsigned char   AD_seqIndex = 0 ;               // channel being converted
+volatile unsigned char   AD_seqBusy = 0 ;       // a sequence is running
+unsigned char   AD_results[AD_SEQ_MAX] ;        // 8 MSB of each channel of the sequence
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * Interrupt service routine
+ * This function MUST be included by user in the interrupt_low() routine,
+ * before ACQ_ISR
+ * one call stores one result of the sequence and starts the next conversion
+ ***********************************/
+void    AD_ISR()
+        {
+        if(AD_seqBusy && PIR1.ADIF)
+                {
+                AD_results[AD_seqIndex] = AD_RESULT8 ;
+                PIR1.ADIF = 0 ;                 // the conversion is not a sample for ACQ_ISR
+
+                if(++AD_seqIndex == AD_seqLength)
+                        {
+                        AD_seqBusy = 0 ;
+                        return ;
+                        }
+
+                AD_start(AD_seq[AD_seqIndex]) ;
+                }
+        }
+
+/************************************************************
+ * AD_init : A/D converter initialization
+ * parameters :
+ *      acqt : automatic acquisition time, ADCON2 ACQT field (AD_ACQT_4TAD)
+ *      adcs : conversion clock, ADCON2 ADCS field (AD_ADCS_FOSC32)
+ * returns :
+ *      nothing
+ * requires :
+ *      analog pins must have been configured in ADCON1
+ * notes :
+ *      the result is left justified, the A/D interrupt is enabled at
+ *      low priority (interrupts must be in priority mode)
+ */
+void    AD_init(unsigned char acqt, unsigned char adcs)
+        {
+        ADCON0 = 0 ;                    // A/D off
+        ADCON2 = AD_ADCON2(acqt & 0x07, adcs & 0x07) ;
+        ADCON0.ADON = 1 ;               // A/D on, channel 0
+        AD_channel = 0 ;
+
+        AD_seqBusy = 0 ;
+        IPR1.ADIP = 0 ;                 // A/D is low priority
+        PIR1.ADIF = 0 ;
+        PIE1.ADIE = 1 ;                 // enable A/D interrupt
+        }
+
+/************************************************************
+ * AD_select : select the channel of the next conversions
+ * parameters :
+ *      ch : analog channel
+ * returns :
+ *      nothing
+ * requires :
+ *      AD_init must have been called, no conversion must be running
+ * notes :
+ *      ADCON0 is written only if the channel changes
+ */
+void    AD_select(unsigned char ch)
+        {
+        ch &= 0x0f ;
+        if(ch == AD_channel) return ;
+
+        ADCON0 = (ch << 2) | 0x01 ;     // channel, A/D on
+        AD_channel = ch ;
+        }
+
+/************************************************************
+ * AD_start : start one conversion
+ * parameters :
+ *      ch : analog channel
+ * returns :
+ *      nothing, the conversion is done when AD_busy returns 0
+ * requires :
+ *      AD_init must have been called, no conversion must be running
+ * notes :
+ *      the acquisition time is counted by the converter : GO is set
+ *      right after the channel
+ */
+void    AD_start(unsigned char ch)
+        {
+        AD_select(ch) ;
+        ADCON0.GO = 1 ;
+        }
+
+/************************************************************
+ * AD_busy : conversion status
+ * parameters :
+ *      none
+ * returns :
+ *      1 while the conversion started by AD_start is running
+ * requires :
+ *      AD_init must have been called
+ * notes :
+ *      the result is then read with AD_RESULT8 or AD_RESULT10
+ */
+unsigned char   AD_busy()
+        {
+        return(ADCON0.GO ? 1 : 0) ;
+        }
+
+/************************************************************
+ * AD_sequence : convert several channels in turn
+ * parameters :
+ *      ch : channels, converted in this order
+ *      n : number of channels, [1;AD_SEQ_MAX]
+ * returns :
+ *      nothing, the sequence is done when AD_sequenceDone returns 1
+ * requires :
+ *      AD_init must have been called, the acquisition must be stopped
+ * notes :
+ *      the result of ch[i] is in AD_results[i]
+ */
+void    AD_sequence(unsigned char *ch, unsigned char n)
+        {
+        unsigned char   i ;
+
+        if(n == 0) return ;
+        if(n > AD_SEQ_MAX) n = AD_SEQ_MAX ;
+
+        for(i = 0 ; i < n ; i++)
+                {
+                AD_seq[i] = ch[i] ;
+                }
+        AD_seqLength = n ;
+        AD_seqIndex = 0 ;
+        AD_seqBusy = 1 ;
+
+        AD_start(AD_seq[0]) ;
+        }
+
+/************************************************************
+ * AD_sequenceDone : sequence status
+ * parameters :
+ *      none
+ * returns :
+ *      1 when the results of the last sequence are in AD_results
+ * requires :
+ *      AD_init must have been called
+ * notes :
+ *      none
+ */
+unsigned char   AD_sequenceDone()
+        {
+        return(AD_seqBusy ? 0 : 1) ;
+        }
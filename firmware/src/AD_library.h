@@ -0,0 +1,18 @@
+#define AD_ADCS_FOSC32          0b010   // TAD = 1 us @ 32 Mhz, shortest TAD above the 0.7 us minimum
+#define AD_ACQT_4TAD            0b010   // 4 us automatic acquisition, above the 2.45 us TACQ
+#define AD_ADCON2(acqt, adcs)   (((acqt) << 3) | (adcs))        // left justified
+
+#define AD_RESULT8              ADRESH  // 8 MSB of the left justified result
+#define AD_RESULT10             (((unsigned int)ADRESH << 2) | (ADRESL >> 6))
+
+#define AD_SEQ_MAX              4       // channels in a sequence
+
+extern  unsigned char   AD_results[AD_SEQ_MAX] ;
+
+void    AD_ISR() ;
+void    AD_init(unsigned char acqt, unsigned char adcs) ;
+void    AD_select(unsigned char ch) ;
+void    AD_start(unsigned char ch) ;
+unsigned char   AD_busy() ;
+void    AD_sequence(unsigned char *ch, unsigned char n) ;
+unsigned char   AD_sequenceDone() ;
@@ -0,0 +1,321 @@
+/*
+ * file         : DEEP_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      deep record for PIC18 MCU
+ *      ACQ_library keeps one screen of samples (ACQ_DEPTH). The deep record
+ *      keeps up to DEEP_DEPTH samples since the record was armed, in
+ *      DEEP_BYTES of RAM : each sample is stored as it arrives, as a 4 bits
+ *      difference with the previous one, or escaped with its 8 bits when the
+ *      difference does not fit. Min/max pairs are two curves, a sample is
+ *      compared with the previous one of the same kind.
+ *
+ *      the levels of the min/max pyramid above the samples are not kept :
+ *      the two levels of the zoom, 256 and 128 min/max pairs, would take
+ *      768 bytes, and the arrays of the libraries already take 1.6 KB of
+ *      the 2 KB of RAM. The zoom is bounded instead, to DEEP_ENV_SHIFT_MAX :
+ *      DEEP_envNext decodes 2^shift samples, 4 at most, and returns their
+ *      envelope (min and max), a column costs O(1). A screen is PAL_X
+ *      columns : 128, 256 or 512 (DEEP_DEPTH) decodes from 1:1 to the
+ *      widest zoom, plus less than DEEP_BLOCK to reach its first sample,
+ *      whatever the pan.
+ *
+ *      the record is cut in blocks of DEEP_BLOCK samples whose first
+ *      samples are escaped, so that each block decodes on its own : when
+ *      the bytes run out, the oldest block is dropped, and a window of the
+ *      record is decoded from the block it starts in. A smooth signal
+ *      takes a little more than 4 bits per sample, and the record is
+ *      DEEP_BLOCKS long ; a noisy one takes up to 12 bits per sample and
+ *      the record gets shorter, down to 5 blocks, more than a screen.
+ *
+ *      the record ends with the ACQ_library record, and freezes with it :
+ *      when it is long enough, its last ACQ_DEPTH samples are the ones of
+ *      ACQ_buffer. It starts when the record is armed, the samples before
+ *      the ACQ_library pre-trigger ones are those of the wait for the
+ *      trigger.
+ *
+ *      DEEP_push is called by ACQ_ISR for each stored sample, DEEP_begin
+ *      and DEEP_next decode a window of the frozen record for the main loop,
+ *      DEEP_envBegin and DEEP_envNext its envelopes.
+ *
+ * target devices :
+ *      PIC18F4550 @ 32 Mhz (8 Mhz instruction clock)
+ */
+
+#include        "DEEP_library.h"
+
+/***************
+ * RAM variables
+ ***************/
+unsigned char   DEEP_pool[DEEP_BYTES] ;         // nibbles, high one first
+unsigned char   DEEP_start[DEEP_BLOCKS] ;       // first byte of each block, circular
+unsigned char   DEEP_first = 0 ;                // oldest block in DEEP_start
+unsigned char   DEEP_blocks = 0 ;               // blocks in the record, the last one is being filled
+unsigned char   DEEP_fill = DEEP_BLOCK ;        // samples in the last block
+unsigned char   DEEP_at = 0 ;                   // byte of the next nibble
+unsigned char   DEEP_half = 0 ;                 // next nibble is the low one
+unsigned char   DEEP_stride = 1 ;               // 2 for min/max pairs
+unsigned char   DEEP_prev[2] ;                  // last two samples
+
+unsigned char   DEEP_rdBlock ;                  // decoder : block in DEEP_start
+unsigned char   DEEP_rdAt ;                     // decoder : next byte
+unsigned char   DEEP_rdHalf ;                   // decoder : next nibble is the low one
+unsigned char   DEEP_rdLeft ;                   // decoder : samples left in the block
+unsigned char   DEEP_rdPrev[2] ;                // decoder : last two samples
+
+unsigned char   DEEP_envShift ;                 // decoder : log2 of samples per envelope
+unsigned char   DEEP_envMin, DEEP_envMax ;      // decoder : envelope read by DEEP_envNext
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * DEEP_put : store a nibble, drop the oldest block when the record is full
+ ***********************************/
+static void     DEEP_put(unsigned char n)
+        {
+        if(DEEP_half)
+                {
+                DEEP_pool[DEEP_at] |= n ;
+                DEEP_at = (DEEP_at + 1) & (DEEP_BYTES - 1) ;
+                DEEP_half = 0 ;
+                return ;
+                }
+
+        if((DEEP_blocks > 1) && (DEEP_at == DEEP_start[DEEP_first]))
+                {
+                DEEP_first = (DEEP_first + 1) & (DEEP_BLOCKS - 1) ;
+                DEEP_blocks-- ;
+                }
+        DEEP_pool[DEEP_at] = n << 4 ;
+        DEEP_half = 1 ;
+        }
+
+/************************************
+ * DEEP_get : read a nibble
+ ***********************************/
+static unsigned char    DEEP_get()
+        {
+        unsigned char   n ;
+
+        if(DEEP_rdHalf)
+                {
+                DEEP_rdHalf = 0 ;
+                n = DEEP_pool[DEEP_rdAt] & 0x0f ;
+                DEEP_rdAt = (DEEP_rdAt + 1) & (DEEP_BYTES - 1) ;
+                return(n) ;
+                }
+
+        DEEP_rdHalf = 1 ;
+        return(DEEP_pool[DEEP_rdAt] >> 4) ;
+        }
+
+/************************************************************
+ * DEEP_clear : start a new record
+ * parameters :
+ *      stride : 2 if the samples are min/max pairs, 1 otherwise
+ * returns :
+ *      nothing
+ * requires :
+ *      nothing
+ * notes :
+ *      called by ACQ_arm, with the low priority interrupts off
+ */
+void    DEEP_clear(unsigned char stride)
+        {
+        DEEP_first = 0 ;
+        DEEP_blocks = 0 ;
+        DEEP_fill = DEEP_BLOCK ;        // the first sample starts a block
+        DEEP_at = 0 ;
+        DEEP_half = 0 ;
+        DEEP_stride = stride ;
+        }
+
+/************************************************************
+ * DEEP_push : store a sample
+ * parameters :
+ *      s : sample
+ * returns :
+ *      nothing
+ * requires :
+ *      DEEP_clear must have been called
+ * notes :
+ *      called by ACQ_ISR for each sample stored in ACQ_buffer
+ */
+void    DEEP_push(unsigned char s)
+        {
+        unsigned char   d ;
+
+        if(DEEP_fill == DEEP_BLOCK)
+                {
+                if(DEEP_half)                   // a block starts on a byte
+                        {
+                        DEEP_at = (DEEP_at + 1) & (DEEP_BYTES - 1) ;
+                        DEEP_half = 0 ;
+                        }
+                if(DEEP_blocks == DEEP_BLOCKS)
+                        {
+                        DEEP_first = (DEEP_first + 1) & (DEEP_BLOCKS - 1) ;
+                        DEEP_blocks-- ;
+                        }
+                DEEP_start[(DEEP_first + DEEP_blocks) & (DEEP_BLOCKS - 1)] = DEEP_at ;
+                DEEP_blocks++ ;
+                DEEP_fill = 0 ;
+                }
+
+        d = s - DEEP_prev[DEEP_stride - 1] ;
+        if((DEEP_fill >= DEEP_stride) && ((d <= DEEP_DELTA_MAX) || (d >= (unsigned char)-DEEP_DELTA_MAX)))
+                {
+                DEEP_put(d & 0x0f) ;
+                }
+        else
+                {
+                DEEP_put(DEEP_ESCAPE) ;
+                DEEP_put(s >> 4) ;
+                DEEP_put(s & 0x0f) ;
+                }
+
+        DEEP_prev[1] = DEEP_prev[0] ;
+        DEEP_prev[0] = s ;
+        DEEP_fill++ ;
+        }
+
+/************************************************************
+ * DEEP_length : samples in the record
+ * parameters :
+ *      none
+ * returns :
+ *      number of samples, from ACQ_DEPTH on the last ACQ_DEPTH ones are
+ *      those of ACQ_buffer
+ * requires :
+ *      nothing
+ * notes :
+ *      the record is frozen when ACQ_ready returns 1
+ */
+unsigned int    DEEP_length()
+        {
+        if(DEEP_blocks == 0) return(0) ;
+
+        return((unsigned int)(DEEP_blocks - 1) * DEEP_BLOCK + DEEP_fill) ;
+        }
+
+/************************************************************
+ * DEEP_begin : start decoding the record
+ * parameters :
+ *      from : first sample to decode, 0 is the oldest one
+ * returns :
+ *      nothing
+ * requires :
+ *      the record must be frozen (between ACQ_take and ACQ_release),
+ *      from must be below DEEP_length()
+ * notes :
+ *      decoding starts at the block of sample from, up to DEEP_BLOCK - 1
+ *      samples are decoded and skipped
+ */
+void    DEEP_begin(unsigned int from)
+        {
+        unsigned char   skip ;
+
+        DEEP_rdBlock = (DEEP_first + (from / DEEP_BLOCK)) & (DEEP_BLOCKS - 1) ;
+        DEEP_rdAt = DEEP_start[DEEP_rdBlock] ;
+        DEEP_rdHalf = 0 ;
+        DEEP_rdLeft = DEEP_BLOCK ;
+
+        skip = from & (DEEP_BLOCK - 1) ;
+        while(skip--) DEEP_next() ;
+        }
+
+/************************************************************
+ * DEEP_next : next sample of the record
+ * parameters :
+ *      none
+ * returns :
+ *      the sample
+ * requires :
+ *      DEEP_begin must have been called
+ * notes :
+ *      no check is done against the end of the record
+ */
+unsigned char   DEEP_next()
+        {
+        unsigned char   n, s ;
+
+        if(DEEP_rdLeft == 0)                    // next block, it starts on a byte
+                {
+                DEEP_rdBlock = (DEEP_rdBlock + 1) & (DEEP_BLOCKS - 1) ;
+                DEEP_rdAt = DEEP_start[DEEP_rdBlock] ;
+                DEEP_rdHalf = 0 ;
+                DEEP_rdLeft = DEEP_BLOCK ;
+                }
+        DEEP_rdLeft-- ;
+
+        n = DEEP_get() ;
+        if(n == DEEP_ESCAPE)
+                {
+                s = DEEP_get() << 4 ;
+                s |= DEEP_get() ;
+                }
+        else
+                {
+                s = DEEP_rdPrev[DEEP_stride - 1] + n ;
+                if(n & 0x08) s -= 16 ;          // negative difference
+                }
+
+        DEEP_rdPrev[1] = DEEP_rdPrev[0] ;
+        DEEP_rdPrev[0] = s ;
+
+        return(s) ;
+        }
+
+/************************************************************
+ * DEEP_envBegin : start reading the envelopes of the record
+ * parameters :
+ *      from : first sample of the first envelope, 0 is the oldest one
+ *      shift : log2 of samples per envelope, [0;DEEP_ENV_SHIFT_MAX]
+ * returns :
+ *      nothing
+ * requires :
+ *      the record must be frozen (between ACQ_take and ACQ_release),
+ *      from must be below DEEP_length()
+ * notes :
+ *      shift 0 gives the samples as they are, in DEEP_envMin and DEEP_envMax
+ */
+void    DEEP_envBegin(unsigned int from, unsigned char shift)
+        {
+        if(shift > DEEP_ENV_SHIFT_MAX) shift = DEEP_ENV_SHIFT_MAX ;
+
+        DEEP_envShift = shift ;
+        DEEP_begin(from) ;
+        }
+
+/************************************************************
+ * DEEP_envNext : next envelope of the record
+ * parameters :
+ *      none
+ * returns :
+ *      nothing, the envelope is in DEEP_envMin and DEEP_envMax
+ * requires :
+ *      DEEP_envBegin must have been called
+ * notes :
+ *      no check is done against the end of the record
+ *      decodes 2^shift samples, DEEP_ENV_SHIFT_MAX bounds the cost
+ */
+void    DEEP_envNext()
+        {
+        unsigned char   n, s ;
+
+        s = DEEP_next() ;
+        DEEP_envMin = s ;
+        DEEP_envMax = s ;
+
+        n = (unsigned char)((1 << DEEP_envShift) - 1) ;
+        while(n--)
+                {
+                s = DEEP_next() ;
+                if(s < DEEP_envMin) DEEP_envMin = s ;
+                if(s > DEEP_envMax) DEEP_envMax = s ;
+                }
+        }
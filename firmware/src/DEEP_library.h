@@ -0,0 +1,19 @@
+#define DEEP_BYTES              256     // compressed record size, power of 2 : the byte indexes are masked
+#define DEEP_BLOCK              32      // samples per block, a block decodes on its own
+#define DEEP_BLOCKS             16      // blocks in the record
+#define DEEP_DEPTH              (DEEP_BLOCK * DEEP_BLOCKS)      // longest record (samples), 4 screens
+
+#define DEEP_ESCAPE             0x08    // escape nibble, the sample follows in two nibbles
+#define DEEP_DELTA_MAX          7       // largest difference in one nibble
+
+#define DEEP_ENV_SHIFT_MAX      2       // envelopes of up to 4 samples, the longest record on one screen
+
+extern  unsigned char   DEEP_envMin, DEEP_envMax ;
+
+void    DEEP_clear(unsigned char stride) ;
+void    DEEP_push(unsigned char s) ;
+unsigned int    DEEP_length() ;
+void    DEEP_begin(unsigned int from) ;
+unsigned char   DEEP_next() ;
+void    DEEP_envBegin(unsigned int from, unsigned char shift) ;
+void    DEEP_envNext() ;
@@ -0,0 +1,251 @@
+/*
+ * file         : EXP_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      sample export for PIC18 MCU
+ *      each record taken by the main loop can be sent on the EUSART (RC6)
+ *      as one frame : header with a sequence number, the timebase and the
+ *      input range of the record, its samples as 4 bits differences, and
+ *      a CRC. A noisy record whose differences would take more than a
+ *      byte per sample is sent raw. tools/host/EXP_decode.cpp turns the frames into CSV or
+ *      binary files.
+ *
+ *      the frame is encoded at once in a ring buffer, and the EUSART
+ *      transmit interrupt sends it one byte at a time : the main loop never
+ *      waits for the link. When the previous frames leave no room for a
+ *      full frame, the record is dropped : its sequence number is used
+ *      anyway, and the next frame tells how many records were dropped, so
+ *      the host can tell the records the link was too slow for from the
+ *      frames lost on the way.
+ *
+ *      the transmission runs on the LOW priority interrupt, it must be
+ *      called by user like this :
+ *      void interrupt_low() { EXP_ISR() ; }
+ *
+ * target devices :
+ *      PIC18F4550 @ 32 Mhz (8 Mhz instruction clock)
+ */
+
+#include        "ACQ_library.h"
+#include        "MEAS_library.h"
+#include        "EXP_library.h"
+
+/***************
+ * RAM variables
+ ***************/
+unsigned char   EXP_ring[EXP_RING] ;            // transmit ring buffer
+volatile unsigned char   EXP_head = 0 ;         // end of the last complete frame, written by EXP_record
+volatile unsigned char   EXP_tail = 0 ;         // next byte to send, written by EXP_ISR
+unsigned char   EXP_seq = 0 ;                   // sequence number of the next record
+unsigned char   EXP_dropped = 0 ;               // records dropped since the last frame
+unsigned char   EXP_nibble ;                    // pending high nibble
+unsigned char   EXP_half ;                      // a high nibble is pending
+unsigned char   EXP_at ;                        // next byte of the frame being encoded
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * EXP_put : append a byte to the frame being encoded
+ ***********************************/
+static void     EXP_put(unsigned char b)
+        {
+        EXP_ring[EXP_at++] = b ;        // wraps on 8 bits
+        }
+
+/************************************
+ * EXP_putNibble : append a nibble to the frame being encoded
+ ***********************************/
+static void     EXP_putNibble(unsigned char n)
+        {
+        if(EXP_half)
+                {
+                EXP_put(EXP_nibble | n) ;
+                EXP_half = 0 ;
+                }
+        else
+                {
+                EXP_nibble = n << 4 ;
+                EXP_half = 1 ;
+                }
+        }
+
+/************************************
+ * EXP_crc : CRC-16 CCITT of n bytes of the ring from index i
+ * one byte at a time without table : the polynomial is folded in shifts
+ ***********************************/
+static unsigned int     EXP_crc(unsigned char i, unsigned char n)
+        {
+        unsigned int    crc ;
+        unsigned char   x ;
+
+        crc = 0xffff ;
+        while(n--)
+                {
+                x = (unsigned char)(crc >> 8) ^ EXP_ring[i++] ;
+                x ^= x >> 4 ;
+                crc = (crc << 8) ^ ((unsigned int)x << 12) ^ ((unsigned int)x << 5) ^ x ;
+                }
+
+        return(crc) ;
+        }
+
+/************************************************************
+ * EXP_ISR : sample export interrupt routine
+ * This function MUST be included by user in the interrupt_low() routine
+ * one call sends one byte
+ ***********************************/
+void    EXP_ISR()
+        {
+        if(PIE1.TXIE && PIR1.TXIF)
+                {
+                TXREG = EXP_ring[EXP_tail] ;    // clears TXIF
+                EXP_tail++ ;
+                if(EXP_tail == EXP_head) PIE1.TXIE = 0 ;        // ring is empty
+                }
+        }
+
+/************************************************************
+ * EXP_init : sample export initialization
+ * parameters :
+ *      brg : baud rate generator, EXP_BAUD_115200 to EXP_BAUD_1000000
+ * returns :
+ *      nothing
+ * requires :
+ *      ACQ_init must have been called (interrupt priorities)
+ * notes :
+ *      this function takes control of the EUSART, transmit only on RC6,
+ *      8 bits, no parity, 1 stop bit
+ */
+void    EXP_init(unsigned int brg)
+        {
+        PIE1.TXIE = 0 ;
+        EXP_head = 0 ;
+        EXP_tail = 0 ;
+        EXP_seq = 0 ;
+        EXP_dropped = 0 ;
+
+        TRISC.F6 = 0 ;                  // TX is an output
+        BAUDCON.BRG16 = 1 ;             // 16 bits baud rate generator
+        SPBRGH = brg >> 8 ;
+        SPBRG = brg ;
+        TXSTA = 0b00100100 ;            // 8 bits, transmit enabled, asynchronous, high speed
+        RCSTA = 0b10000000 ;            // serial port enabled, receiver off
+        IPR1.TXIP = 0 ;                 // transmit interrupt is low priority
+        }
+
+/************************************************************
+ * EXP_record : send a record
+ * parameters :
+ *      first : index of the first sample of the record, from ACQ_take
+ *      stamp : time stamp of the record, in the caller units
+ * returns :
+ *      1 if the frame is queued, 0 if the record is dropped
+ * requires :
+ *      EXP_init must have been called,
+ *      the record must be frozen (between ACQ_take and ACQ_release)
+ * notes :
+ *      the frame is sent by EXP_ISR while the main loop goes on
+ */
+unsigned char   EXP_record(unsigned char first, unsigned int stamp)
+        {
+        unsigned char   start, body, i, s, p, d, stride ;
+        unsigned long   column ;
+        unsigned int    crc ;
+
+        /*
+         * room for the largest frame, one byte is kept free
+         * so that a full ring is not taken for an empty one,
+         * the nibbles may run 2 bytes past a raw payload before they are given up
+         */
+        if((unsigned char)(EXP_tail - EXP_head - 1) < EXP_FRAME_MAX + 2)
+                {
+                EXP_seq++ ;
+                if(EXP_dropped != 0xff) EXP_dropped++ ;
+                return(0) ;
+                }
+
+        column = ACQ_ets ? ACQ_etsStep : (unsigned long)ACQ_period << ACQ_decimShift ;
+
+        start = EXP_head ;
+        EXP_at = start ;
+        EXP_half = 0 ;
+
+        EXP_put(EXP_SYNC) ;
+        EXP_put(EXP_TYPE_RECORD) ;
+        EXP_put(EXP_seq) ;
+        EXP_put(0) ;                    // payload length, known at the end
+
+        EXP_put((unsigned char)stamp) ;
+        EXP_put((unsigned char)(stamp >> 8)) ;
+        EXP_put((unsigned char)column) ;
+        EXP_put((unsigned char)(column >> 8)) ;
+        EXP_put((unsigned char)(column >> 16)) ;
+        EXP_put(ACQ_ets | (ACQ_decimMode << 1)) ;
+        EXP_put(ACQ_ets ? 0 : ACQ_pre) ;
+        EXP_put((unsigned char)MEAS_calibration[MEAS_range].span) ;
+        EXP_put((unsigned char)(MEAS_calibration[MEAS_range].span >> 8)) ;
+        EXP_put(MEAS_calibration[MEAS_range].zero) ;
+        EXP_put(EXP_dropped) ;
+        EXP_put(ACQ_DEPTH) ;
+
+        /*
+         * samples : 4 bits differences with a linear prediction from the two
+         * previous samples, escaped when they do not fit
+         * min/max pairs are two interleaved curves : a sample is predicted
+         * from the previous ones of the same kind
+         */
+        body = EXP_at ;
+        stride = (!ACQ_ets && (ACQ_decimMode == ACQ_DECIM_PEAK)) ? 2 : 1 ;
+        for(i = 0 ; i < ACQ_DEPTH ; i++)
+                {
+                s = ACQ_SAMPLE(first, i) ;
+                p = ACQ_SAMPLE(first, i - stride) ;
+                if(i >= stride * 2) p += (unsigned char)(p - ACQ_SAMPLE(first, i - stride * 2)) ;
+                d = s - p ;
+                if((i >= stride) && ((d <= EXP_DELTA_MAX) || (d >= (unsigned char)-EXP_DELTA_MAX)))
+                        {
+                        EXP_putNibble(d & 0x0f) ;
+                        }
+                else
+                        {
+                        EXP_putNibble(EXP_ESCAPE) ;
+                        EXP_putNibble(s >> 4) ;
+                        EXP_putNibble(s & 0x0f) ;
+                        }
+                if((unsigned char)(EXP_at - body) > ACQ_DEPTH) break ;
+                }
+        if(EXP_half) EXP_put(EXP_nibble) ;
+
+        /*
+         * more than a byte per sample : the samples are sent as they are
+         */
+        if((unsigned char)(EXP_at - body) > ACQ_DEPTH)
+                {
+                EXP_ring[(unsigned char)(start + EXP_HEADER + EXP_META_FLAGS)] |= EXP_FLAG_RAW ;
+                EXP_at = body ;
+                for(i = 0 ; i < ACQ_DEPTH ; i++)
+                        {
+                        EXP_put(ACQ_SAMPLE(first, i)) ;
+                        }
+                }
+
+        EXP_ring[(unsigned char)(start + 3)] = (unsigned char)(EXP_at - start - EXP_HEADER) ;
+        crc = EXP_crc(start + 1, (unsigned char)(EXP_at - start - 1)) ;
+        EXP_put((unsigned char)(crc >> 8)) ;
+        EXP_put((unsigned char)crc) ;
+
+        /*
+         * the frame is complete : hand it to EXP_ISR
+         */
+        EXP_head = EXP_at ;
+        PIE1.TXIE = 1 ;
+
+        EXP_seq++ ;
+        EXP_dropped = 0 ;
+
+        return(1) ;
+        }
@@ -0,0 +1,55 @@
+#define EXP_SYNC                0xa5    // first byte of a frame
+#define EXP_TYPE_RECORD         0x01    // frame type : one trigger aligned record
+
+#define EXP_BAUD_115200         68      // SPBRGH:SPBRG at 32 MHz, BRG16 = BRGH = 1
+#define EXP_BAUD_250000         31
+#define EXP_BAUD_500000         15
+#define EXP_BAUD_1000000        7
+
+#define EXP_RING                256     // transmit ring size, the indexes wrap on 8 bits
+
+/*
+ * frame : header, payload, CRC
+ *      sync, type, sequence, payload length
+ *      payload
+ *      CRC-16 CCITT (0x1021, initial 0xffff) of type to end of payload, MSB first
+ * multi-byte fields of the payload are LSB first
+ */
+#define EXP_HEADER              4       // header size
+#define EXP_CRC                 2       // CRC size
+
+/*
+ * record payload : metadata, then the samples as nibbles, high nibble first
+ *      nibble -7 to +7 : difference with the prediction 2 * s[i - 1] - s[i - 2]
+ *              (s[i - 1] for the second sample), modulo 256. Min/max pairs
+ *              (peak decimation, not ETS) are two curves : s[i - 2] and
+ *              s[i - 4] are used
+ *      nibble EXP_ESCAPE : the sample follows in two nibbles, high one first
+ * the first samples are always escaped, a last odd nibble is padded with 0
+ * when the nibbles would take more than ACQ_DEPTH bytes, the samples are
+ * sent as they are instead, one byte each, and the flags tell so
+ */
+#define EXP_META_STAMP          0       // 16 bits stamp given by the caller
+#define EXP_META_COLUMN         2       // 24 bits time between two samples (instruction cycles)
+#define EXP_META_FLAGS          5       // bit 0 : ETS, bits 1-2 : decimation mode, bit 3 : EXP_FLAG_RAW
+#define EXP_META_PRE            6       // samples before the trigger point
+#define EXP_META_SPAN           7       // 16 bits mV for 256 sample codes
+#define EXP_META_ZERO           9       // sample code of 0 V
+#define EXP_META_DROPPED        10      // records dropped since the previous frame
+#define EXP_META_SAMPLES        11      // samples in the record
+#define EXP_META                12      // metadata size
+
+#define EXP_FLAG_RAW            0x08    // samples are bytes, not nibbles
+
+#define EXP_ESCAPE              0x08    // escape nibble, -8 is not a difference
+#define EXP_DELTA_MAX           7       // largest difference in one nibble
+
+#define EXP_PAYLOAD_MAX         (EXP_META + ACQ_DEPTH)  // raw samples, the nibbles are never longer
+#define EXP_FRAME_MAX           (EXP_HEADER + EXP_PAYLOAD_MAX + EXP_CRC)
+
+extern  unsigned char   EXP_seq ;
+extern  unsigned char   EXP_dropped ;
+
+void    EXP_ISR() ;
+void    EXP_init(unsigned int brg) ;
+unsigned char   EXP_record(unsigned char first, unsigned int stamp) ;
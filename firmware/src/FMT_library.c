@@ -0,0 +1,164 @@
+/*
+ * file         : FMT_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      float free number formatting for PIC18 MCU
+ *      integer values are written in engineering notation with SI prefix,
+ *      for example 1562 mHz is written "1.562 Hz" and 23320 mV "23.3 V".
+ *      digits are extracted by subtracting powers of ten : no division,
+ *      no multiplication, no float library.
+ *
+ * cycle budget (instruction cycles, 8 Mhz instruction clock) :
+ *      digit extraction   : 10 digits, at most 9 subtractions of 32 bits each
+ *                           about 1100 cycles worst case
+ *      rounding & output  : about 250 cycles for 4 digits and a 2 chars unit
+ *      total              : < 1400 cycles (175 us) per call, about 0.5 % of
+ *                           a 40 ms frame for the two readouts.
+ *      sprintf("%g") with the 24 bits float library is more than ten times that.
+ */
+
+#include        "FMT_library.h"
+
+/*****************
+ * ROM tables
+ *****************/
+const unsigned long     FMT_pow10[10] =
+        {
+        1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+        } ;
+
+/*
+ * SI prefixes from 10^-12 to 10^9, no prefix for 10^0
+ */
+const char      FMT_prefix[] = "pnum kMG" ;
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * FMT_exponent : decimal exponent of the leading digit d[first]
+ ***********************************/
+static signed char      FMT_exponent(unsigned char first, signed char e, unsigned char lead)
+        {
+        if(lead == 0) return(0) ;                       // 0 has no prefix
+
+        return((signed char)(10 - first) + e) ;
+        }
+
+/************************************
+ * FMT_prefixExponent : exponent of the SI prefix of x, a multiple of 3
+ ***********************************/
+static signed char      FMT_prefixExponent(signed char x)
+        {
+        signed char     x3 ;
+
+        x3 = (x >= 0) ? (x / 3) * 3 : -(((2 - x) / 3) * 3) ;
+        if(x3 < -12) x3 = -12 ;
+        if(x3 > 9) x3 = 9 ;
+
+        return(x3) ;
+        }
+
+/********************************
+ * FMT_eng : engineering notation
+ * parameters :
+ *      dst : destination string, at least digits + 4 + strlen(unit) bytes (FMT_SIZE)
+ *      v : value, in 10^e units
+ *      e : decimal exponent of v unit [-12;0] (clamped), -3 for mV or mHz
+ *      digits : significant digits [1;10]
+ *      unit : unit string, "V" or "Hz" for example
+ * returns :
+ *      length of dst
+ * requires :
+ *      nothing
+ * notes :
+ *      the integer part has 1 to 3 digits, digits is raised to fit it
+ *      if needed, before rounding. v is rounded half up.
+ *      u is used for micro, the font has no greek letter.
+ */
+unsigned char   FMT_eng(char *dst, unsigned long v, signed char e, unsigned char digits, const char *unit)
+        {
+        unsigned char   d[11] ;         // d[0] is room for a rounding carry
+        unsigned char   i, n, first, ip ;
+        signed char     x, x3 ;
+        char            *p ;
+
+        /*
+         * decimal digits, most significant first
+         */
+        d[0] = 0 ;
+        for(i = 0 ; i < 10 ; i++)
+                {
+                n = 0 ;
+                while(v >= FMT_pow10[i])
+                        {
+                        v -= FMT_pow10[i] ;
+                        n++ ;
+                        }
+                d[i + 1] = n ;
+                }
+
+        first = 1 ;
+        while((first < 10) && (d[first] == 0)) first++ ;        // 0 keeps one digit
+
+        if(digits == 0) digits = 1 ;
+        if(digits > 10) digits = 10 ;
+        if(e < -12) e = -12 ;                           // the integer part keeps 1 to 3 digits
+        if(e > 0) e = 0 ;
+
+        /*
+         * exponent of the leading digit, of the SI prefix, and integer
+         * part digits : digits is raised to fit them before rounding
+         */
+        x = FMT_exponent(first, e, d[first]) ;
+        x3 = FMT_prefixExponent(x) ;
+        ip = (unsigned char)(x - x3 + 1) ;
+        if(digits < ip) digits = ip ;
+
+        /*
+         * round to digits significant digits
+         */
+        if(first + digits <= 10)
+                {
+                if(d[first + digits] >= 5)
+                        {
+                        i = (unsigned char)(first + digits - 1) ;
+                        while(++d[i] == 10)
+                                {
+                                d[i--] = 0 ;
+                                }
+                        if(i < first)                   // carry went one digit left : 999 -> 1000
+                                {
+                                first = i ;
+                                x = FMT_exponent(first, e, d[first]) ;
+                                x3 = FMT_prefixExponent(x) ;
+                                ip = (unsigned char)(x - x3 + 1) ;
+                                if(digits < ip) digits = ip ;   // the new digit is rounded, the others are 0
+                                }
+                        }
+                }
+
+        /*
+         * mantissa
+         */
+        p = dst ;
+        for(i = 0 ; i < digits ; i++)
+                {
+                if(i == ip) *p++ = '.' ;
+                n = first + i ;
+                *p++ = '0' + ((n <= 10) ? d[n] : 0) ;
+                }
+
+        /*
+         * prefix and unit
+         */
+        *p++ = ' ' ;
+        if(x3) *p++ = FMT_prefix[(x3 + 12) / 3] ;
+        while(*unit) *p++ = *unit++ ;
+        *p = 0 ;
+
+        return((unsigned char)(p - dst)) ;
+        }
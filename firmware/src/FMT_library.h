@@ -0,0 +1,3 @@
+#define FMT_SIZE                12      // buffer size for up to 4 digits and 3 chars unit
+
+unsigned char   FMT_eng(char *dst, unsigned long v, signed char e, unsigned char digits, const char *unit) ;
@@ -0,0 +1,259 @@
+/*
+ * file         : FREQ_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      reciprocal frequency counter for PIC18 MCU
+ *      a comparator or schmitt trigger conditioned copy of the input drives
+ *      RC2/CCP1. CCP1 captures the free running TIMER 1 on rising edges
+ *      (every 1, 4 or 16 edges, depending on the frequency) and TIMER 1
+ *      overflows extend the time stamps to 32 bits.
+ *      a gate closes on the first edge after FREQ_GATE cycles : the number of
+ *      edges and the exact time between the first and the last one give the
+ *      frequency with the resolution of the instruction clock, whatever the
+ *      frequency. Gates follow each other without dead time.
+ *
+ *      the division is done by FREQ_read, in the main loop, once per gate.
+ *
+ * target devices :
+ *      PIC18F4550 @ 32 Mhz (8 Mhz instruction clock)
+ */
+
+#include        "FREQ_library.h"
+
+/***************
+ * RAM variables
+ ***************/
+INT_U16         FREQ_ovf = 0 ;                  // TIMER 1 overflows, bits 16 to 31 of time stamps
+INT_U32         FREQ_start = 0 ;                // time stamp of the first edge of the gate
+INT_U32         FREQ_edges = 0 ;                // edges since FREQ_start
+unsigned int    FREQ_captures = 0 ;             // captures since FREQ_start
+unsigned char   FREQ_prescale = 1 ;             // edges per capture : 1, 4 or 16
+unsigned char   FREQ_first = 1 ;                // next capture opens the gate
+unsigned char   FREQ_idle = 0 ;                 // TIMER 1 overflows since last capture
+volatile unsigned char   FREQ_done = 0 ;        // a gate result is available
+INT_U32         FREQ_resEdges = 0 ;             // gate result : edges
+INT_U32         FREQ_resSpan = 0 ;              // gate result : cycles
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * FREQ_setPrescale : select edges per capture
+ * restarts the gate
+ ***********************************/
+static void     FREQ_setPrescale(unsigned char p)
+        {
+        FREQ_prescale = p ;
+
+        CCP1CON = 0 ;           // changing the prescaler may generate a false capture
+        switch(p)
+                {
+                case 16: CCP1CON = 0b00000111 ; break ;         // every 16th rising edge
+                case 4:  CCP1CON = 0b00000110 ; break ;         // every 4th rising edge
+                default: CCP1CON = 0b00000101 ; break ;         // every rising edge
+                }
+
+        FREQ_first = 1 ;
+        }
+
+/************************************
+ * FREQ_mulDiv : a * b / c with a 64 bits intermediate product
+ * the quotient must fit in 32 bits
+ ***********************************/
+static INT_U32  FREQ_mulDiv(INT_U32 a, INT_U32 b, INT_U32 c)
+        {
+        INT_U32         hi, lo, mid, t, q ;
+        unsigned char   i ;
+
+        /*
+         * 64 bits product from four 16x16 bits products
+         */
+        lo = (INT_U32)(INT_U16)a * (INT_U16)b ;
+        hi = (INT_U32)(INT_U16)(a >> 16) * (INT_U16)(b >> 16) ;
+        mid = (INT_U32)(INT_U16)(a >> 16) * (INT_U16)b ;
+        t = (INT_U32)(INT_U16)a * (INT_U16)(b >> 16) ;
+        mid += t ;
+        if(mid < t) hi += 0x10000 ;     // carry of middle sum
+        hi += mid >> 16 ;
+        mid <<= 16 ;
+        lo += mid ;
+        if(lo < mid) hi++ ;             // carry of low sum
+
+        /*
+         * shift and subtract division, hi is the running remainder
+         */
+        q = 0 ;
+        for(i = 0 ; i < 32 ; i++)
+                {
+                t = hi & 0x80000000 ;
+                hi = (hi << 1) | (lo >> 31) ;
+                lo <<= 1 ;
+                q <<= 1 ;
+                if(t || (hi >= c))
+                        {
+                        hi -= c ;
+                        q |= 1 ;
+                        }
+                }
+
+        return(q) ;
+        }
+
+/************************************
+ * Interrupt service routine
+ * This function MUST be included by user in the interrupt_low() routine
+ * handles TIMER 1 overflows
+ ***********************************/
+void    FREQ_ISR()
+        {
+        if(PIR1.TMR1IF)
+                {
+                PIR1.TMR1IF = 0 ;
+                FREQ_ovf++ ;
+
+                if(++FREQ_idle == FREQ_IDLE_MAX)        // no edge for a long time
+                        {
+                        FREQ_idle = 0 ;
+                        FREQ_resEdges = 0 ;             // report 0 Hz
+                        FREQ_done = 1 ;
+                        if(FREQ_prescale != 1) FREQ_setPrescale(1) ;
+                        FREQ_first = 1 ;
+                        }
+                }
+        }
+
+/************************************
+ * FREQ_edge : input edge
+ * This function MUST be called by user in the interrupt_low() routine
+ * when CCP1 has captured an edge on RC2, before clearing PIR1.CCP1IF.
+ * CCP1 is shared with ACQ_library.
+ ***********************************/
+void    FREQ_edge()
+        {
+        INT_U32         stamp ;
+        INT_U32         span ;
+        INT_U16         hi ;
+
+        /*
+         * 32 bits time stamp, an overflow may be pending if the
+         * capture occured just after TIMER 1 wrapped around
+         */
+        hi = FREQ_ovf ;
+        if(PIR1.TMR1IF && !(CCPR1H & 0x80)) hi++ ;
+        stamp = ((INT_U32)hi << 16) | (((INT_U16)CCPR1H << 8) | CCPR1L) ;
+
+        FREQ_idle = 0 ;
+
+        if(FREQ_first)          // open the gate
+                {
+                FREQ_first = 0 ;
+                FREQ_start = stamp ;
+                FREQ_edges = 0 ;
+                FREQ_captures = 0 ;
+                return ;
+                }
+
+        FREQ_edges += FREQ_prescale ;
+        FREQ_captures++ ;
+
+        span = stamp - FREQ_start ;
+        if(span < FREQ_GATE) return ;
+
+        /*
+         * close the gate and open the next one on the same edge
+         */
+        if(!FREQ_done)
+                {
+                FREQ_resEdges = FREQ_edges ;
+                FREQ_resSpan = span ;
+                FREQ_done = 1 ;
+                }
+
+        FREQ_start = stamp ;
+        FREQ_edges = 0 ;
+
+        /*
+         * keep the capture rate low enough for the interrupt latency
+         */
+        if((FREQ_captures > FREQ_CAPTURES_MAX) && (FREQ_prescale != 16))
+                {
+                FREQ_setPrescale(FREQ_prescale << 2) ;
+                }
+        else if((FREQ_captures < FREQ_CAPTURES_MAX / 8) && (FREQ_prescale != 1))
+                {
+                FREQ_setPrescale(FREQ_prescale >> 2) ;
+                }
+
+        FREQ_captures = 0 ;
+        }
+
+/************************************************************
+ * FREQ_init : frequency counter initialization
+ * parameters :
+ *      none
+ * returns :
+ *      nothing
+ * requires :
+ *      RC2 must be an input
+ * notes :
+ *      this function takes control of TIMER 1 (free running) and CCP1,
+ *      interrupts are low priority, RCON.IPEN is set by ACQ_init
+ */
+void    FREQ_init()
+        {
+        T1CON = 0b10000001 ;            // 16 bits, prescaler = 1, free running, TIMER 1 is CCP1 clock source
+
+        FREQ_setPrescale(1) ;
+
+        IPR1.TMR1IP = 0 ;               // low priority
+        IPR1.CCP1IP = 0 ;
+        PIR1.TMR1IF = 0 ;
+        PIR1.CCP1IF = 0 ;
+        PIE1.TMR1IE = 1 ;
+        PIE1.CCP1IE = 1 ;
+        }
+
+/**********************************************
+ * FREQ_ready : is a new measure available ?
+ * parameters :
+ *      none
+ * returns :
+ *      1 if a gate has been closed since last FREQ_read, 0 otherwise
+ * requires :
+ *      FREQ_init must have been called
+ * notes :
+ *      none
+ */
+unsigned char   FREQ_ready()
+        {
+        return(FREQ_done) ;
+        }
+
+/**********************************************
+ * FREQ_read : read last measure
+ * parameters :
+ *      none
+ * returns :
+ *      frequency in mHz [0;2^32-1]
+ * requires :
+ *      FREQ_ready must have returned 1
+ * notes :
+ *      one 64/32 bits division, call it once per gate, not once per frame
+ */
+unsigned long   FREQ_read()
+        {
+        INT_U32         edges, span ;
+
+        INTCON.GIEL = 0 ;       // gate result is written by FREQ_edge
+        edges = FREQ_resEdges ;
+        span = FREQ_resSpan ;
+        FREQ_done = 0 ;
+        INTCON.GIEL = 1 ;
+
+        if(edges == 0) return(0) ;
+
+        return(FREQ_mulDiv(edges * 1000, FREQ_FCY, span)) ;
+        }
@@ -0,0 +1,14 @@
+#include        "INT_types.h"
+
+#define FREQ_FCY                8000000L        // instruction clock (Hz)
+#define FREQ_GATE               800000L         // minimum gate time in instruction cycles (100 ms)
+#define FREQ_IDLE_MAX           250             // TIMER 1 overflows without edge before 0 Hz (2 s)
+#define FREQ_CAPTURES_MAX       (FREQ_GATE / 1024)      // captures per gate before prescaling
+
+extern  INT_U16         FREQ_ovf ;
+
+void    FREQ_ISR() ;
+void    FREQ_edge() ;
+void    FREQ_init() ;
+unsigned char   FREQ_ready() ;
+unsigned long   FREQ_read() ;
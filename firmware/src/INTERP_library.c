@@ -0,0 +1,148 @@
+/*
+ * file         : INTERP_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      record interpolation for PIC18 MCU
+ *      at the fast timebases sampled in real time (see ACQ_setSparse), a
+ *      screen holds fewer samples than columns : 2^shift columns per
+ *      sample. This library rebuilds the columns between the samples of
+ *      the record, with straight lines or with a windowed sin(x)/x that
+ *      keeps the shape of a sine down to a few samples per period.
+ *
+ *      the sin(x)/x coefficients are fixed point (1/128) ROM tables built
+ *      on the host by tools/INTERP_table.cpp, one row of INTERP_TAPS per
+ *      phase of each upsampling factor : a column costs INTERP_TAPS
+ *      multiply and adds, the same for every column and every factor, the
+ *      loop has no exit that depends on the samples. The columns that fall
+ *      on a sample are the sample itself. tools/host/INTERP_check.cpp
+ *      compares the columns with a double precision interpolation.
+ *
+ *      the samples are kept minus 128 in a window of INTERP_TAPS that
+ *      slides by one sample every 2^shift columns ; the samples beyond the
+ *      ends of the record repeat its first or last one.
+ *
+ * target devices :
+ *      PIC18F4550 @ 32 Mhz (8 Mhz instruction clock)
+ */
+
+#include        "ACQ_library.h"
+#include        "INTERP_library.h"
+
+/***************
+ * RAM variables
+ ***************/
+signed char     INTERP_win[INTERP_TAPS] ;       // samples k - 3 to k + 4, minus 128
+int             INTERP_at ;                     // record index of the next sample of the window
+unsigned char   INTERP_first ;                  // first sample of the record
+unsigned char   INTERP_shift ;                  // log2 of columns per sample
+unsigned char   INTERP_phase ;                  // column after sample k
+unsigned char   INTERP_mode ;                   // INTERP_LINEAR or INTERP_SINC
+const signed char       *INTERP_row ;           // coefficients of phase 1 of INTERP_shift
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * INTERP_load : append sample INTERP_at of the record to the window
+ ***********************************/
+static void     INTERP_load()
+        {
+        unsigned char   i ;
+
+        for(i = 0 ; i < INTERP_TAPS - 1 ; i++)
+                {
+                INTERP_win[i] = INTERP_win[i + 1] ;
+                }
+
+        if(INTERP_at < 0) i = 0 ;
+        else if(INTERP_at > ACQ_DEPTH - 1) i = ACQ_DEPTH - 1 ;
+        else i = (unsigned char)INTERP_at ;
+        INTERP_win[INTERP_TAPS - 1] = (signed char)(ACQ_SAMPLE(INTERP_first, i) ^ 0x80) ;
+
+        INTERP_at++ ;
+        }
+
+/************************************************************
+ * INTERP_begin : start interpolating the record
+ * parameters :
+ *      first : index of the first sample of the record, from ACQ_take
+ *      from : first sample of the screen, in the record
+ *      shift : log2 of columns per sample, [0;INTERP_SHIFT_MAX]
+ *      mode : INTERP_LINEAR or INTERP_SINC
+ * returns :
+ *      nothing
+ * requires :
+ *      the record must be frozen (between ACQ_take and ACQ_release)
+ * notes :
+ *      shift 0 gives the samples as they are
+ */
+void    INTERP_begin(unsigned char first, unsigned char from, unsigned char shift, unsigned char mode)
+        {
+        unsigned char   i ;
+
+        if(shift > INTERP_SHIFT_MAX) shift = INTERP_SHIFT_MAX ;
+
+        INTERP_first = first ;
+        INTERP_shift = shift ;
+        INTERP_mode = mode ;
+        INTERP_phase = 0 ;
+        if(shift) INTERP_row = INTERP_sinc + (((1 << shift) - shift - 1) * INTERP_TAPS) ;
+
+        INTERP_at = (int)from - 3 ;
+        for(i = 0 ; i < INTERP_TAPS ; i++)
+                {
+                INTERP_load() ;
+                }
+        }
+
+/************************************************************
+ * INTERP_next : next column
+ * parameters :
+ *      none
+ * returns :
+ *      the sample of the column
+ * requires :
+ *      INTERP_begin must have been called
+ * notes :
+ *      sin(x)/x overshoots are clipped to the sample range
+ */
+unsigned char   INTERP_next()
+        {
+        const signed char       *c ;
+        unsigned char   i, n ;
+        int             acc ;
+
+        if(INTERP_phase == 0)                   // on sample k
+                {
+                acc = INTERP_win[3] ;
+                }
+        else if(INTERP_mode == INTERP_LINEAR)
+                {
+                n = 1 << INTERP_shift ;
+                acc = (int)(((unsigned int)(unsigned char)(INTERP_win[3] ^ 0x80) * (n - INTERP_phase)
+                        + (unsigned int)(unsigned char)(INTERP_win[4] ^ 0x80) * INTERP_phase) >> INTERP_shift) - 128 ;
+                }
+        else
+                {
+                c = INTERP_row + (INTERP_phase - 1) * INTERP_TAPS ;
+                acc = 64 ;                      // rounding
+                for(i = 0 ; i < INTERP_TAPS ; i++)
+                        {
+                        acc += (int)INTERP_win[i] * c[i] ;
+                        }
+                acc >>= 7 ;
+                if(acc < -128) acc = -128 ;
+                if(acc > 127) acc = 127 ;
+                }
+
+        if(++INTERP_phase == (1 << INTERP_shift))
+                {
+                INTERP_phase = 0 ;
+                INTERP_load() ;
+                }
+
+        return((unsigned char)acc ^ 0x80) ;
+        }
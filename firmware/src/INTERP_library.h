@@ -0,0 +1,10 @@
+#define INTERP_LINEAR           0       // straight lines between the samples
+#define INTERP_SINC             1       // windowed sin(x)/x, INTERP_TAPS samples per point
+
+#define INTERP_TAPS             8       // samples k - 3 to k + 4 around a point after sample k
+#define INTERP_SHIFT_MAX        4       // upsampling by 2^INTERP_SHIFT_MAX at most
+
+extern  const signed char       INTERP_sinc[] ;
+
+void    INTERP_begin(unsigned char first, unsigned char from, unsigned char shift, unsigned char mode) ;
+unsigned char   INTERP_next() ;
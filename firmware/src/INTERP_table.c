@@ -0,0 +1,52 @@
+/*
+ * file         : INTERP_table.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      INTERP library ROM table, generated by tools/INTERP_table.cpp, do not edit
+ *      Lanczos window, 8 taps, upsampling by 2 to 16
+ */
+
+#include        "INTERP_library.h"
+
+/*****************
+ * ROM tables
+ *****************/
+/*
+ * coefficients in 1/128 of the samples k - 3 to k + 4, for each phase
+ * but 0 of each shift : phase p of shift s is at ((1 << s) - s - 2 + p) * INTERP_TAPS
+ */
+const signed char       INTERP_sinc[((1 << (INTERP_SHIFT_MAX + 1)) - INTERP_SHIFT_MAX - 2) * INTERP_TAPS] =
+        {
+        // x2
+          -2,    8,  -21,   79,   79,  -21,    8,   -2,      // 1/2
+        // x4
+          -2,    7,  -20,  115,   36,  -12,    4,    0,      // 1/4
+          -2,    8,  -21,   79,   79,  -21,    8,   -2,      // 2/4
+           0,    4,  -12,   36,  115,  -20,    7,   -2,      // 3/4
+        // x8
+          -1,    4,  -12,  125,   16,   -6,    2,    0,      // 1/8
+          -2,    7,  -20,  115,   36,  -12,    4,    0,      // 2/8
+          -2,    8,  -22,   99,   58,  -18,    6,   -1,      // 3/8
+          -2,    8,  -21,   79,   79,  -21,    8,   -2,      // 4/8
+          -1,    6,  -18,   58,   99,  -22,    8,   -2,      // 5/8
+           0,    4,  -12,   36,  115,  -20,    7,   -2,      // 6/8
+           0,    2,   -6,   16,  125,  -12,    4,   -1,      // 7/8
+        // x16
+          -1,    3,   -7,  127,    8,   -3,    1,    0,      // 1/16
+          -1,    4,  -12,  125,   16,   -6,    2,    0,      // 2/16
+          -2,    6,  -16,  120,   26,   -9,    3,    0,      // 3/16
+          -2,    7,  -20,  115,   36,  -12,    4,    0,      // 4/16
+          -2,    8,  -21,  107,   47,  -15,    5,   -1,      // 5/16
+          -2,    8,  -22,   99,   58,  -18,    6,   -1,      // 6/16
+          -2,    8,  -22,   89,   69,  -20,    7,   -1,      // 7/16
+          -2,    8,  -21,   79,   79,  -21,    8,   -2,      // 8/16
+          -1,    7,  -20,   69,   89,  -22,    8,   -2,      // 9/16
+          -1,    6,  -18,   58,   99,  -22,    8,   -2,      // 10/16
+          -1,    5,  -15,   47,  107,  -21,    8,   -2,      // 11/16
+           0,    4,  -12,   36,  115,  -20,    7,   -2,      // 12/16
+           0,    3,   -9,   26,  120,  -16,    6,   -2,      // 13/16
+           0,    2,   -6,   16,  125,  -12,    4,   -1,      // 14/16
+           0,    1,   -3,    8,  127,   -7,    3,   -1      // 15/16
+        } ;
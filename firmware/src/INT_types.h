@@ -0,0 +1,21 @@
+/*
+ * explicit width integers, for the arithmetic that relies on the wrap
+ * around of 16 or 32 bits (time stamps, 64 bits products) :
+ * mikroC int is 16 bits and long is 32 bits, the host build (PAL_HOST)
+ * has wider ones. Cast the results that must wrap, a 16 bits operand is
+ * promoted to a 32 bits int on the host.
+ */
+#ifndef INT_TYPES_H
+#define INT_TYPES_H
+
+#ifdef PAL_HOST
+#include        <stdint.h>
+
+typedef uint16_t        INT_U16 ;
+typedef uint32_t        INT_U32 ;
+#else
+typedef unsigned int    INT_U16 ;
+typedef unsigned long   INT_U32 ;
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * file         : MEAS_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      voltage measurements for PIC18 MCU
+ *      ACQ_ISR keeps the record min, max, sum and sum of squares up to date
+ *      as samples arrive, so the end of record computation is a handful of
+ *      32 bits integer operations and one integer square root : no float,
+ *      no pass over the record.
+ *
+ *      voltage of a sample, in mV : (s - zero) * span / 256
+ *      span and zero are the calibration constants of the input range
+ *
+ *      in peak decimation, the record holds min/max pairs, not samples :
+ *      their mean and RMS are biased towards the extremes, the undecimated
+ *      samples are not summed. Mean and RMS are not computed then, only
+ *      min, max and peak to peak, which come from every sample.
+ */
+
+#include        "ACQ_library.h"
+#include        "MEAS_library.h"
+
+/*****************
+ * ROM tables
+ *****************/
+const MEAS_CALIBRATION  MEAS_calibration[MEAS_RANGE_COUNT] =
+        {
+        { 30000, 128 },         // +/- 15 V
+        { 10000, 128 },         // +/- 5 V
+        {  3000, 128 }          // +/- 1.5 V
+        } ;
+
+/***************
+ * RAM variables
+ ***************/
+unsigned char   MEAS_range = MEAS_RANGE_15V ;   // current input range
+int             MEAS_vmin = 0 ;                 // min voltage (mV)
+int             MEAS_vmax = 0 ;                 // max voltage (mV)
+unsigned int    MEAS_vpp = 0 ;                  // peak to peak voltage (mV)
+int             MEAS_mean = 0 ;                 // mean voltage (mV)
+unsigned int    MEAS_rms = 0 ;                  // RMS voltage (mV)
+unsigned char   MEAS_meanValid = 0 ;            // MEAS_mean and MEAS_rms are those of the last record
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * MEAS_sqrt : integer square root
+ * 16 iterations, no multiplication
+ ***********************************/
+static unsigned int     MEAS_sqrt(unsigned long x)
+        {
+        unsigned long   r, b ;
+
+        r = 0 ;
+        b = 0x40000000 ;
+        while(b > x) b >>= 2 ;
+
+        while(b)
+                {
+                if(x >= r + b)
+                        {
+                        x -= r + b ;
+                        r = (r >> 1) + b ;
+                        }
+                else
+                        {
+                        r >>= 1 ;
+                        }
+                b >>= 2 ;
+                }
+
+        return((unsigned int)r) ;
+        }
+
+/**********************************************
+ * MEAS_setRange : select input range calibration
+ * parameters :
+ *      r : MEAS_RANGE_15V, MEAS_RANGE_5V or MEAS_RANGE_1V5
+ * returns :
+ *      nothing
+ * requires :
+ *      nothing
+ * notes :
+ *      takes effect on next MEAS_record
+ */
+void    MEAS_setRange(unsigned char r)
+        {
+        if(r >= MEAS_RANGE_COUNT) r = MEAS_RANGE_COUNT - 1 ;
+
+        MEAS_range = r ;
+        }
+
+/**********************************************
+ * MEAS_record : compute measurements of the current record
+ * parameters :
+ *      none
+ * returns :
+ *      nothing, results are in MEAS_vmin, MEAS_vmax, MEAS_vpp, MEAS_mean, MEAS_rms
+ * requires :
+ *      the record must be frozen (between ACQ_take and ACQ_release)
+ * notes :
+ *      mean and RMS are computed over the ACQ_DEPTH samples of the record,
+ *      min and max over all samples since the record was armed
+ *      in peak decimation, mean and RMS are left as they are and
+ *      MEAS_meanValid is 0
+ */
+void    MEAS_record()
+        {
+        unsigned long   span ;
+        unsigned char   zero ;
+        long            z ;
+        long            sq ;
+
+        span = MEAS_calibration[MEAS_range].span ;
+        zero = MEAS_calibration[MEAS_range].zero ;
+
+        MEAS_vmin = (int)(((long)((int)ACQ_min - zero) * (long)span) >> 8) ;
+        MEAS_vmax = (int)(((long)((int)ACQ_max - zero) * (long)span) >> 8) ;
+        MEAS_vpp = (unsigned int)(((unsigned long)(ACQ_max - ACQ_min) * span) >> 8) ;
+
+        /*
+         * min/max pairs are not samples
+         */
+        MEAS_meanValid = (ACQ_ets || (ACQ_decimMode != ACQ_DECIM_PEAK)) ? 1 : 0 ;
+        if(!MEAS_meanValid) return ;
+
+        /*
+         * mean : sum is 128 times the mean sample code
+         */
+        z = (long)zero * ACQ_DEPTH ;
+        MEAS_mean = (int)((((long)ACQ_sum - z) * (long)span) >> (8 + 7)) ;
+
+        /*
+         * RMS around 0 V : sum((s - zero)^2) = sumSq - 2 zero sum + N zero^2
+         * sqrt(2 * sum / 128) is 16 times the RMS sample code
+         */
+        sq = (long)ACQ_sumSq - 2 * (long)zero * ACQ_sum + z * zero ;
+        MEAS_rms = (unsigned int)(((unsigned long)MEAS_sqrt((unsigned long)sq << 1) * span) >> (8 + 4)) ;
+        }
@@ -0,0 +1,25 @@
+#define MEAS_RANGE_15V          0       // input range +/- 15 V
+#define MEAS_RANGE_5V           1       // input range +/- 5 V
+#define MEAS_RANGE_1V5          2       // input range +/- 1.5 V
+#define MEAS_RANGE_COUNT        3
+
+/*
+ * calibration of an input range
+ */
+typedef struct
+        {
+        unsigned int    span ;          // mV for 256 sample codes
+        unsigned char   zero ;          // sample code of 0 V
+        } MEAS_CALIBRATION ;
+
+extern  const MEAS_CALIBRATION  MEAS_calibration[] ;
+extern  unsigned char   MEAS_range ;
+extern  int             MEAS_vmin ;
+extern  int             MEAS_vmax ;
+extern  unsigned int    MEAS_vpp ;
+extern  int             MEAS_mean ;
+extern  unsigned int    MEAS_rms ;
+extern  unsigned char   MEAS_meanValid ;
+
+void    MEAS_setRange(unsigned char r) ;
+void    MEAS_record() ;
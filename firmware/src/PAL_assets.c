@@ -0,0 +1,62 @@
+/*
+ * file         : PAL_assets.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      PAL library ROM assets, generated by tools/PAL_assets.cpp, do not edit
+ *      PAL_assets -c " .0123456789DGHIMPVWkmnpuz"
+ *      26 glyphs of the TERMINAL font, 304 bytes
+ */
+
+#include        "PAL_library.h"
+
+/*****************
+ * ROM tables
+ *****************/
+/*
+ * glyph of chars PAL_CHAR_FIRST to PAL_CHAR_LAST, 0 is space
+ */
+const unsigned char     PAL_charIndex[PAL_CHAR_LAST - PAL_CHAR_FIRST + 1] =
+        {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+        2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 12, 0, 0, 13, 14, 15, 0, 0, 0, 16, 0, 0,
+        17, 0, 0, 0, 0, 0, 18, 19, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 20, 0, 21, 22, 0,
+        23, 0, 0, 0, 0, 24, 0, 0, 0, 0, 25, 0, 0, 0, 0, 0
+        } ;
+
+/*
+ * glyphs : 8 bytes per glyph, one per pixel line from top to bottom,
+ * bit 0 is the leftmost pixel as in the screen map
+ */
+const unsigned char     PAL_charTable[] =
+        {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,      // ' '
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00,      // '.'
+        0x0E, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0E, 0x00,      // '0'
+        0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00,      // '1'
+        0x0E, 0x11, 0x10, 0x0E, 0x01, 0x01, 0x1F, 0x00,      // '2'
+        0x1F, 0x10, 0x08, 0x0C, 0x10, 0x11, 0x0E, 0x00,      // '3'
+        0x08, 0x0C, 0x0A, 0x09, 0x1F, 0x08, 0x08, 0x00,      // '4'
+        0x1F, 0x01, 0x0F, 0x10, 0x10, 0x11, 0x0E, 0x00,      // '5'
+        0x1C, 0x02, 0x01, 0x0F, 0x11, 0x11, 0x0E, 0x00,      // '6'
+        0x1F, 0x10, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00,      // '7'
+        0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x00,      // '8'
+        0x0E, 0x11, 0x11, 0x1E, 0x10, 0x08, 0x07, 0x00,      // '9'
+        0x0F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0F, 0x00,      // 'D'
+        0x1E, 0x11, 0x01, 0x01, 0x19, 0x11, 0x1E, 0x00,      // 'G'
+        0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00,      // 'H'
+        0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00,      // 'I'
+        0x11, 0x1B, 0x15, 0x15, 0x15, 0x11, 0x11, 0x00,      // 'M'
+        0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01, 0x01, 0x00,      // 'P'
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00,      // 'V'
+        0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A, 0x00,      // 'W'
+        0x01, 0x01, 0x09, 0x05, 0x03, 0x05, 0x09, 0x00,      // 'k'
+        0x00, 0x00, 0x0B, 0x15, 0x15, 0x15, 0x15, 0x00,      // 'm'
+        0x00, 0x00, 0x0D, 0x13, 0x11, 0x11, 0x11, 0x00,      // 'n'
+        0x00, 0x00, 0x0D, 0x13, 0x13, 0x0D, 0x01, 0x01,      // 'p'
+        0x00, 0x00, 0x11, 0x11, 0x11, 0x19, 0x16, 0x00,      // 'u'
+        0x00, 0x00, 0x1F, 0x08, 0x04, 0x02, 0x1F, 0x00       // 'z'
+        } ;
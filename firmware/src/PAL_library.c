@@ -33,7 +33,8 @@
  * see more details on http://www.micro-examples.com/
  */
 
-#include        "PAL_Library.h"
+#include        "PAL_library.h"
+#include        "PROF_library.h"
 
 /*
  * I/O definition
@@ -41,44 +42,84 @@
 #define PAL_BSYNC   PORTE.F0    // bit for synchronization
 #define PAL_BVID    PORTD.F0    // bit for luminance. Note : full PORT is reserved !
 
-#define PAL_DELAY4  1           // real delay in microsecond for 4 �s pulse
-#define PAL_DELAY28 20          // real delay in microsecond for 28 �s pulse
+/*
+ * sync pulses are timed by TIMER 2, in instruction cycles :
+ * TIMER 2 restarts from 0 when it matches PR2, so consecutive parts add up exactly
+ */
+#define PAL_T4          32      // 4 us part of a sync line
+#define PAL_T28         224     // 28 us part of a sync line
+#define PAL_THSYNC      37      // 4.7 us horizontal sync
+#define PAL_SYNC_LEAD   12      // cycles from PAL_ISR start to TIMER 2 start
+#define PAL_SYNC_LAT    20      // cycles from a TIMER 2 match to the level written by PAL_ISR
+
+/*
+ * vertical blank budget, in instruction cycles
+ */
+#define PAL_LINE_CYCLES 512     // one line of 64 us
+#define PAL_INFO_LINES  18      // info lines after the sync lines
+#define PAL_INFO_ISR    100     // PAL_ISR time of an info line
+#define PAL_BLANK_ISR   200     // PAL_ISR time of a video line out of the picture
+#define PAL_TOP_ISR     600     // extra time of video lines 1 and 2 (vector line, text line)
 
 /********************
  * MACRO DEFINITIONS
  ********************/
 
+#ifdef PAL_HOST
+/*
+ * host build (tools/host) : the asm below is emulated by HAL.cpp,
+ * with the same instruction cycles
+ */
+#define PAL_MAKE_BORDER HAL_asmBorder((unsigned char)PAL_border)
+#define PAL_BLOCK_HEAD  ((void)dummy, HAL_asmHead(ptr, PAL_gratPtr))        // dummy is for mikroC
+#define PAL_BLOCK_SHIFT HAL_asmShift()
+#define PAL_BLOCK_LOAD  HAL_asmLoad()
+#else
 /*
  * create picture border
  */
 #define PAL_MAKE_BORDER asm MOVFF _PAL_border, PORTD
 
+/*
+ * pixels are ORed with the overlay line PAL_gratPtr points to, in ROM,
+ * the first byte is ready in W when the line starts, each next one is
+ * read while the previous one is shifted out : 20 cycles per 8 pixels
+ */
+
 /*
  * header to load first group of 8 pixels
  */
 #define PAL_BLOCK_HEAD\
                         asm { MOVFF        PAL_ISR_ptr_L2, FSR0L }\
                         asm { MOVFF        PAL_ISR_ptr_L2+1, FSR0H }\
-                        asm { MOVFF        POSTINC0, PORTD }
+                        asm { MOVFF        _PAL_gratPtr, TBLPTRL }\
+                        asm { MOVFF        _PAL_gratPtr+1, TBLPTRH }\
+                        asm { CLRF         TBLPTRU, 0 }\
+                        asm { MOVF         POSTINC0, 0, 0 }\
+                        asm { TBLRD*+ }\
+                        asm { IORWF        TABLAT, 0, 0 }\
+                        asm { MOVWF        PORTD, 0 }
 
 /*
  * process 8 pixels
- * pre-fetch next 8 pixels
+ * pre-fetch next 8 pixels and their overlay
  */
 #define PAL_BLOCK_SHIFT\
-                        asm { INFSNZ        PAL_ISR_ptr_L2, 1, 1 }\
-                        asm { INCF        PAL_ISR_ptr_L2+1, 1, 1 }\
-                        asm { RRCF        PORTD, 1, 0 }\
-                        asm { MOVFF        PAL_ISR_ptr_L2, FSR0L }\
+                        asm { MOVF         POSTINC0, 0, 0 }\
+                        asm { nop }\
                         asm { RRCF        PORTD, 1, 0 }\
-                        asm { MOVFF        PAL_ISR_ptr_L2+1, FSR0H }\
+                        asm { nop }\
                         asm { RRCF        PORTD, 1, 0 }\
                         asm { nop }\
+                        asm { nop }\
                         asm { RRCF        PORTD, 1, 0 }\
                         asm { nop }\
                         asm { RRCF        PORTD, 1, 0 }\
+                        asm { TBLRD*+ }\
+                        asm { RRCF        PORTD, 1, 0 }\
                         asm { nop }\
                         asm { RRCF        PORTD, 1, 0 }\
+                        asm { IORWF        TABLAT, 0, 0 }\
                         asm { nop }\
                         asm { RRCF        PORTD, 1, 0 }\
                         asm { nop }
@@ -87,13 +128,148 @@
  * load 8 pixel bloc
  */
 #define PAL_BLOCK_LOAD\
-                        asm { MOVFF        POSTINC0, PORTD }
+                        asm { MOVWF        PORTD, 0 }
+#endif
+
+#ifdef PAL_VECTOR
+/*
+ * vector line : apply the changes of the next row
+ */
+#define PAL_VEC_APPLY\
+                        {\
+                        unsigned char   n, e ;\
+                        n = *PAL_vecCnt++ ;\
+                        while(n--)\
+                                {\
+                                e = *PAL_vecPtr++ ;\
+                                if(e < PAL_VEC_MASK) PAL_vecLine[e >> 3] ^= PAL_vecBit[e & 7] ;\
+                                else if(e < PAL_VEC_FULL) PAL_vecLine[e & 0x0f] ^= *PAL_vecPtr++ ;\
+                                else PAL_vecLine[e & 0x0f] ^= 0xff ;\
+                                }\
+                        }
+
+/*
+ * byte change tokens :
+ *      0 to 127 : toggle pixel of this column
+ *      PAL_VEC_MASK + byte index, mask : toggle pixels of mask
+ *      PAL_VEC_FULL + byte index : toggle all 8 pixels
+ */
+#define PAL_VEC_MASK    0x80
+#define PAL_VEC_FULL    0x90
+#endif
+
+#ifdef PAL_GRAT
+/*
+ * graticule : overlay of the next vector row, one ROM line for its two video lines
+ */
+#define PAL_GRAT_NEXT\
+                        {\
+                        unsigned char   p ;\
+                        p = PAL_GRAT_NONE ;\
+                        if(PAL_gratDiv)\
+                                {\
+                                if(PAL_gratCnt == 0)\
+                                        {\
+                                        p = (PAL_gratRow == PAL_gratCenter) ? PAL_GRAT_AXIS : PAL_GRAT_LINE ;\
+                                        PAL_gratCnt = PAL_gratDiv ;\
+                                        }\
+                                else if(PAL_gratRow & 1) p = PAL_GRAT_DOTS ;\
+                                PAL_gratCnt-- ;\
+                                }\
+                        if((PAL_gratRow == PAL_gratMark[0]) || (PAL_gratRow == PAL_gratMark[1])) p = PAL_GRAT_CURSOR ;\
+                        PAL_gratPtr = PAL_gratPattern + p * (PAL_X / 8) ;\
+                        PAL_gratRow++ ;\
+                        }
+
+/*
+ * overlay lines
+ */
+#define PAL_GRAT_DOTS   1               // dots of the vertical divisions
+#define PAL_GRAT_LINE   2               // horizontal division
+#define PAL_GRAT_AXIS   3               // horizontal axis
+#define PAL_GRAT_CURSOR 4               // trigger level or cursor
+#endif
+#define PAL_GRAT_NONE   0               // no overlay
+
+/*
+ * glyph of char c, chars without glyph are spaces
+ */
+#define PAL_GLYPH(c)    ((((c) < PAL_CHAR_FIRST) || ((c) > PAL_CHAR_LAST)) ? 0 : PAL_charIndex[(c) - PAL_CHAR_FIRST])
 
+#ifdef PAL_TEXT
 /*
- * set video signal to SYNC or BLACK for d �s
+ * text line : glyph line of the next pixel row for 8 cells,
+ * the whole line is built in two calls, then shown
  */
-#define PAL_HSYNC(d)        PAL_BVID = 0 ; PAL_BSYNC = 0 ; Delay_us(d)
-#define PAL_BLACK(d)        PAL_BVID = 0 ; PAL_BSYNC = 1 ; Delay_us(d)
+#define PAL_TEXT_BUILD\
+                        {\
+                        unsigned char   i, g ;\
+                        unsigned char   *cell, *dst ;\
+                        g = PAL_textRow & 7 ;\
+                        cell = PAL_text + (PAL_textRow >> 3) * PAL_TEXT_COLS + PAL_textHalf ;\
+                        dst = PAL_textBuild + PAL_textHalf ;\
+                        for(i = 0 ; i < PAL_TEXT_COLS / 2 ; i++)\
+                                {\
+                                *dst++ = PAL_charTable[((unsigned int)*cell++ << 3) + g] ;\
+                                }\
+                        if(PAL_textHalf)\
+                                {\
+                                dst = PAL_textShow ;\
+                                PAL_textShow = PAL_textBuild ;\
+                                PAL_textBuild = dst ;\
+                                PAL_textRow++ ;\
+                                PAL_textHalf = 0 ;\
+                                }\
+                        else\
+                                {\
+                                PAL_textHalf = PAL_TEXT_COLS / 2 ;\
+                                }\
+                        }
+#endif
+
+/*
+ * start TIMER 2 for a first part of p cycles, the sync level is low since PAL_ISR start
+ */
+#define PAL_SYNC_START(p)\
+                        TMR2 = PAL_SYNC_LEAD ;\
+                        PR2 = (p) - 1 ;\
+                        PIR1.TMR2IF = 0 ;\
+                        T2CON.TMR2ON = 1
+
+/*
+ * output the next parts of a sync line from PAL_syncCode
+ * 4 us parts are waited for, the ISR returns during 28 us parts and
+ * goes on from the TIMER 2 interrupt. lag is 1 when the level is written
+ * PAL_SYNC_LAT cycles after the match, from the TIMER 2 interrupt.
+ */
+#define PAL_SYNC_PARTS(lag)\
+                        {\
+                        unsigned char   l ;\
+                        l = lag ;\
+                        for(;;)\
+                                {\
+                                PAL_BSYNC = (PAL_syncCode & 1) ? 1 : 0 ;\
+                                if(--PAL_syncLeft == 0)\
+                                        {\
+                                        T2CON.TMR2ON = 0 ;              /* last part lasts up to the end of the line */\
+                                        break ;\
+                                        }\
+                                if(PAL_syncCode & 2)\
+                                        {\
+                                        PR2 = l ? PAL_T4 + PAL_SYNC_LAT - 1 : PAL_T4 - 1 ;\
+                                        PAL_syncCode >>= 2 ;\
+                                        while(!PIR1.TMR2IF) ;\
+                                        PIR1.TMR2IF = 0 ;\
+                                        l = 0 ;\
+                                        }\
+                                else\
+                                        {\
+                                        PR2 = l ? PAL_T28 - 1 : PAL_T28 - PAL_SYNC_LAT - 1 ;\
+                                        PAL_syncCode >>= 2 ;\
+                                        break ;\
+                                        }\
+                                }\
+                        }
 
 /*                                                                       g
  * vertical sync line is made of 4 levels of UP and LOW pulses of 28 and 4 �s
@@ -134,7 +310,7 @@
 /*
  * these info lines are not visible on screen
  */
-#define PAL_LINFO   PAL_P1(PAL_LOW4)  | PAL_P2(PAL_UP4)  | PAL_P3(PAL_UP28)  | PAL_P4(PAL_UP28)
+#define PAL_LINFO   (PAL_P1(PAL_LOW4)  | PAL_P2(PAL_UP4)  | PAL_P3(PAL_UP28)  | PAL_P4(PAL_UP28))
 
 /*
  * this is the code of a visible video line
@@ -167,9 +343,11 @@ const unsigned char   PAL_ltype[] =
 /***************
  * RAM variables
  ***************/
-const   char    *PAL_linePtr = PAL_ltype ;      // pointer to the current line type
+const   unsigned char   *PAL_linePtr = PAL_ltype ;      // pointer to the current line type
 unsigned char   PAL_lineIdx = 0 ;               // index of the current line type
 unsigned char   PAL_lineCode = 0 ;              // current line code
+unsigned char   PAL_syncCode ;                  // sync line parts still to output
+unsigned char   PAL_syncLeft = 0 ;              // number of parts of the sync line left
 unsigned int    PAL_lineVideo = 0 ;             // current visible video line number
 unsigned int    PAL_border = 0 ;                // border flag : 1=white border, 0=black border
 unsigned char   PAL_y ;                         // number of vertical pixels
@@ -177,273 +355,97 @@ unsigned int    PAL_max_y ;                     // last video line number
 unsigned char   PAL_shift_y ;                   // first video line number (vertical centering)
 unsigned char   PAL_render ;                    // start rendering flag
 unsigned long   PAL_frameCtr = 0 ;              // frame counter, 25 per second
+volatile unsigned char  PAL_vblank = 0 ;        // set on each new frame
+void            (*PAL_vblankHook)() = 0 ;       // called by PAL_ISR on each new frame
+unsigned char   PAL_mapY ;                      // number of vertical pixels in PAL_screen
+
+#ifdef PAL_VECTOR
+/*
+ * vector area : the rows below PAL_vecTop are not stored in PAL_screen,
+ * the ISR keeps one line of 16 bytes and applies to it, row after row,
+ * a list of byte changes built by PAL_vecCommit from the column spans.
+ * there are two lists, one on screen and one being built.
+ */
+unsigned char   PAL_vecLo[PAL_X] ;                      // first row of each column
+unsigned char   PAL_vecHi[PAL_X] ;                      // last row of each column
+unsigned char   PAL_vecPool[2][PAL_X * 2] ;             // byte change tokens, at most 2 per column
+unsigned char   PAL_vecCount[2][PAL_VEC_ROWS] ;         // tokens per row
+unsigned char   PAL_vecLine[PAL_X / 8] ;                // current vector line
+unsigned char   *PAL_vecPtr ;                           // next byte change
+unsigned char   *PAL_vecCnt ;                           // byte changes of next row
+unsigned char   PAL_vecLeft = 0 ;                       // rows to update in this field
+unsigned char   PAL_vecFront = 0 ;                      // list on screen
+volatile unsigned char  PAL_vecSwap = 0 ;               // back list is ready
+unsigned char   PAL_vecTop ;                            // first row of vector area
+unsigned char   PAL_vecRows = 0 ;                       // number of rows of vector area
+unsigned int    PAL_vecStart ;                          // first video line of vector area
+#endif
+
+/*
+ * overlay : each video line is ORed with a ROM line of PAL_gratPattern,
+ * the ISR picks it for each row of the vector area, there is nothing
+ * to draw or erase in the main loop.
+ */
+const unsigned char     *PAL_gratPtr ;                  // overlay of current line
+#ifdef PAL_GRAT
+unsigned char   PAL_gratDiv = 0 ;                       // rows per division, 0 is no grid
+unsigned char   PAL_gratCenter ;                        // row of horizontal axis
+unsigned char   PAL_gratFirst ;                         // rows before first division of vector area
+unsigned char   PAL_gratCnt ;                           // rows before next division
+unsigned char   PAL_gratRow ;                           // next row
+unsigned char   PAL_gratMark[PAL_GRAT_CURSORS] = { PAL_GRAT_OFF, PAL_GRAT_OFF } ;    // cursor rows
+#endif
+
+#ifdef PAL_TEXT
+/*
+ * text area : the rows above PAL_vecTop are cells of 8 x 8 pixels,
+ * the ISR builds each pixel line from PAL_charTable while the previous one
+ * is on screen.
+ */
+unsigned char   PAL_text[PAL_TEXT_ROWS * PAL_TEXT_COLS] ;       // glyph of each cell
+unsigned char   PAL_textLine[2][PAL_TEXT_COLS] ;                // pixel lines
+unsigned char   *PAL_textShow = PAL_textLine[0] ;               // pixel line on screen
+unsigned char   *PAL_textBuild = PAL_textLine[1] ;              // next pixel line
+unsigned char   PAL_textRow = 0 ;                               // row of next pixel line
+unsigned char   PAL_textHalf = 0 ;                              // first cell of next build
+#endif
 
 /*****************
  * ROM tables
  *****************/
+#ifdef PAL_VECTOR
+const unsigned char     PAL_vecBit[8] =
+        {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+        } ;
+#endif
+
 /*
- * TERMINAL fonts
- * 6x8 ASCII character table, starts from 0 (32 = space) up to 255
- *
+ * overlay lines, a division every 16 pixels, bit 0 is the leftmost pixel
  */
-const unsigned char     PAL_charTable[] = {
-                0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-                0x3E, 0x5B, 0x4F, 0x5B, 0x3E, 0x00,
-                0x3E, 0x6B, 0x4F, 0x6B, 0x3E, 0x00,
-                0x1C, 0x3E, 0x7C, 0x3E, 0x1C, 0x00,
-                0x18, 0x3C, 0x7E, 0x3C, 0x18, 0x00,
-                0x1C, 0x57, 0x7D, 0x57, 0x1C, 0x00,
-                0x1C, 0x5E, 0x7F, 0x5E, 0x1C, 0x00,
-                0x00, 0x18, 0x3C, 0x18, 0x00, 0x00,
-                0xFF, 0xE7, 0xC3, 0xE7, 0xFF, 0x00,
-                0x00, 0x18, 0x24, 0x18, 0x00, 0x00,
-                0xFF, 0xE7, 0xDB, 0xE7, 0xFF, 0x00,
-                0x30, 0x48, 0x3A, 0x06, 0x0E, 0x00,
-                0x26, 0x29, 0x79, 0x29, 0x26, 0x00,
-                0x40, 0x7F, 0x05, 0x05, 0x07, 0x00,
-                0x40, 0x7F, 0x05, 0x25, 0x3F, 0x00,
-                0x5A, 0x3C, 0xE7, 0x3C, 0x5A, 0x00,
-                0x7F, 0x3E, 0x1C, 0x1C, 0x08, 0x00,
-                0x08, 0x1C, 0x1C, 0x3E, 0x7F, 0x00,
-                0x14, 0x22, 0x7F, 0x22, 0x14, 0x00,
-                0x5F, 0x5F, 0x00, 0x5F, 0x5F, 0x00,
-                0x06, 0x09, 0x7F, 0x01, 0x7F, 0x00,
-                0x00, 0x66, 0x89, 0x95, 0x6A, 0x00,
-                0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
-                0x94, 0xA2, 0xFF, 0xA2, 0x94, 0x00,
-                0x08, 0x04, 0x7E, 0x04, 0x08, 0x00,
-                0x10, 0x20, 0x7E, 0x20, 0x10, 0x00,
-                0x08, 0x08, 0x2A, 0x1C, 0x08, 0x00,
-                0x08, 0x1C, 0x2A, 0x08, 0x08, 0x00,
-                0x1E, 0x10, 0x10, 0x10, 0x10, 0x00,
-                0x0C, 0x1E, 0x0C, 0x1E, 0x0C, 0x00,
-                0x30, 0x38, 0x3E, 0x38, 0x30, 0x00,
-                0x06, 0x0E, 0x3E, 0x0E, 0x06, 0x00,
-                0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-                0x00, 0x00, 0x5F, 0x00, 0x00, 0x00,
-                0x00, 0x07, 0x00, 0x07, 0x00, 0x00,
-                0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00,
-                0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00,
-                0x23, 0x13, 0x08, 0x64, 0x62, 0x00,
-                0x36, 0x49, 0x56, 0x20, 0x50, 0x00,
-                0x00, 0x08, 0x07, 0x03, 0x00, 0x00,
-                0x00, 0x1C, 0x22, 0x41, 0x00, 0x00,
-                0x00, 0x41, 0x22, 0x1C, 0x00, 0x00,
-                0x2A, 0x1C, 0x7F, 0x1C, 0x2A, 0x00,
-                0x08, 0x08, 0x3E, 0x08, 0x08, 0x00,
-                0x00, 0x80, 0x70, 0x30, 0x00, 0x00,
-                0x08, 0x08, 0x08, 0x08, 0x08, 0x00,
-                0x00, 0x00, 0x60, 0x60, 0x00, 0x00,
-                0x20, 0x10, 0x08, 0x04, 0x02, 0x00,
-                0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00,
-                0x00, 0x42, 0x7F, 0x40, 0x00, 0x00,
-                0x72, 0x49, 0x49, 0x49, 0x46, 0x00,
-                0x21, 0x41, 0x49, 0x4D, 0x33, 0x00,
-                0x18, 0x14, 0x12, 0x7F, 0x10, 0x00,
-                0x27, 0x45, 0x45, 0x45, 0x39, 0x00,
-                0x3C, 0x4A, 0x49, 0x49, 0x31, 0x00,
-                0x41, 0x21, 0x11, 0x09, 0x07, 0x00,
-                0x36, 0x49, 0x49, 0x49, 0x36, 0x00,
-                0x46, 0x49, 0x49, 0x29, 0x1E, 0x00,
-                0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
-                0x00, 0x40, 0x34, 0x00, 0x00, 0x00,
-                0x00, 0x08, 0x14, 0x22, 0x41, 0x00,
-                0x14, 0x14, 0x14, 0x14, 0x14, 0x00,
-                0x00, 0x41, 0x22, 0x14, 0x08, 0x00,
-                0x02, 0x01, 0x59, 0x09, 0x06, 0x00,
-                0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x00,
-                0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00,
-                0x7F, 0x49, 0x49, 0x49, 0x36, 0x00,
-                0x3E, 0x41, 0x41, 0x41, 0x22, 0x00,
-                0x7F, 0x41, 0x41, 0x41, 0x3E, 0x00,
-                0x7F, 0x49, 0x49, 0x49, 0x41, 0x00,
-                0x7F, 0x09, 0x09, 0x09, 0x01, 0x00,
-                0x3E, 0x41, 0x41, 0x51, 0x73, 0x00,
-                0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00,
-                0x00, 0x41, 0x7F, 0x41, 0x00, 0x00,
-                0x20, 0x40, 0x41, 0x3F, 0x01, 0x00,
-                0x7F, 0x08, 0x14, 0x22, 0x41, 0x00,
-                0x7F, 0x40, 0x40, 0x40, 0x40, 0x00,
-                0x7F, 0x02, 0x1C, 0x02, 0x7F, 0x00,
-                0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00,
-                0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00,
-                0x7F, 0x09, 0x09, 0x09, 0x06, 0x00,
-                0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00,
-                0x7F, 0x09, 0x19, 0x29, 0x46, 0x00,
-                0x26, 0x49, 0x49, 0x49, 0x32, 0x00,
-                0x03, 0x01, 0x7F, 0x01, 0x03, 0x00,
-                0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00,
-                0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00,
-                0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00,
-                0x63, 0x14, 0x08, 0x14, 0x63, 0x00,
-                0x03, 0x04, 0x78, 0x04, 0x03, 0x00,
-                0x61, 0x59, 0x49, 0x4D, 0x43, 0x00,
-                0x00, 0x7F, 0x41, 0x41, 0x41, 0x00,
-                0x02, 0x04, 0x08, 0x10, 0x20, 0x00,
-                0x00, 0x41, 0x41, 0x41, 0x7F, 0x00,
-                0x04, 0x02, 0x01, 0x02, 0x04, 0x00,
-                0x40, 0x40, 0x40, 0x40, 0x40, 0x00,
-                0x00, 0x03, 0x07, 0x08, 0x00, 0x00,
-                0x20, 0x54, 0x54, 0x78, 0x40, 0x00,
-                0x7F, 0x28, 0x44, 0x44, 0x38, 0x00,
-                0x38, 0x44, 0x44, 0x44, 0x28, 0x00,
-                0x38, 0x44, 0x44, 0x28, 0x7F, 0x00,
-                0x38, 0x54, 0x54, 0x54, 0x18, 0x00,
-                0x00, 0x08, 0x7E, 0x09, 0x02, 0x00,
-                0x18, 0xA4, 0xA4, 0x9C, 0x78, 0x00,
-                0x7F, 0x08, 0x04, 0x04, 0x78, 0x00,
-                0x00, 0x44, 0x7D, 0x40, 0x00, 0x00,
-                0x20, 0x40, 0x40, 0x3D, 0x00, 0x00,
-                0x7F, 0x10, 0x28, 0x44, 0x00, 0x00,
-                0x00, 0x41, 0x7F, 0x40, 0x00, 0x00,
-                0x7C, 0x04, 0x78, 0x04, 0x78, 0x00,
-                0x7C, 0x08, 0x04, 0x04, 0x78, 0x00,
-                0x38, 0x44, 0x44, 0x44, 0x38, 0x00,
-                0xFC, 0x18, 0x24, 0x24, 0x18, 0x00,
-                0x18, 0x24, 0x24, 0x18, 0xFC, 0x00,
-                0x7C, 0x08, 0x04, 0x04, 0x08, 0x00,
-                0x48, 0x54, 0x54, 0x54, 0x24, 0x00,
-                0x04, 0x04, 0x3F, 0x44, 0x24, 0x00,
-                0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00,
-                0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00,
-                0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00,
-                0x44, 0x28, 0x10, 0x28, 0x44, 0x00,
-                0x4C, 0x90, 0x90, 0x90, 0x7C, 0x00,
-                0x44, 0x64, 0x54, 0x4C, 0x44, 0x00,
-                0x00, 0x08, 0x36, 0x41, 0x00, 0x00,
-                0x00, 0x00, 0x77, 0x00, 0x00, 0x00,
-                0x00, 0x41, 0x36, 0x08, 0x00, 0x00,
-                0x02, 0x01, 0x02, 0x04, 0x02, 0x00,
-                0x3C, 0x26, 0x23, 0x26, 0x3C, 0x00,
-                0x1E, 0xA1, 0xA1, 0x61, 0x12, 0x00,
-                0x3A, 0x40, 0x40, 0x20, 0x7A, 0x00,
-                0x38, 0x54, 0x54, 0x55, 0x59, 0x00,
-                0x21, 0x55, 0x55, 0x79, 0x41, 0x00,
-                0x21, 0x54, 0x54, 0x78, 0x41, 0x00,
-                0x21, 0x55, 0x54, 0x78, 0x40, 0x00,
-                0x20, 0x54, 0x55, 0x79, 0x40, 0x00,
-                0x0C, 0x1E, 0x52, 0x72, 0x12, 0x00,
-                0x39, 0x55, 0x55, 0x55, 0x59, 0x00,
-                0x39, 0x54, 0x54, 0x54, 0x59, 0x00,
-                0x39, 0x55, 0x54, 0x54, 0x58, 0x00,
-                0x00, 0x00, 0x45, 0x7C, 0x41, 0x00,
-                0x00, 0x02, 0x45, 0x7D, 0x42, 0x00,
-                0x00, 0x01, 0x45, 0x7C, 0x40, 0x00,
-                0xF0, 0x29, 0x24, 0x29, 0xF0, 0x00,
-                0xF0, 0x28, 0x25, 0x28, 0xF0, 0x00,
-                0x7C, 0x54, 0x55, 0x45, 0x00, 0x00,
-                0x20, 0x54, 0x54, 0x7C, 0x54, 0x44,
-                0x7C, 0x0A, 0x09, 0x7F, 0x49, 0x41,
-                0x32, 0x49, 0x49, 0x49, 0x32, 0x00,
-                0x32, 0x48, 0x48, 0x48, 0x32, 0x00,
-                0x32, 0x4A, 0x48, 0x48, 0x30, 0x00,
-                0x3A, 0x41, 0x41, 0x21, 0x7A, 0x00,
-                0x3A, 0x42, 0x40, 0x20, 0x78, 0x00,
-                0x00, 0x9D, 0xA0, 0xA0, 0x7D, 0x00,
-                0x39, 0x44, 0x44, 0x44, 0x39, 0x00,
-                0x3D, 0x40, 0x40, 0x40, 0x3D, 0x00,
-                0x3C, 0x24, 0xFF, 0x24, 0x24, 0x00,
-                0x48, 0x7E, 0x49, 0x43, 0x66, 0x00,
-                0x2B, 0x2F, 0xFC, 0x2F, 0x2B, 0x00,
-                0xFF, 0x09, 0x29, 0xF6, 0x20, 0x00,
-                0xC0, 0x88, 0x7E, 0x09, 0x03, 0x00,
-                0x20, 0x54, 0x54, 0x79, 0x41, 0x00,
-                0x00, 0x00, 0x44, 0x7D, 0x41, 0x00,
-                0x30, 0x48, 0x48, 0x4A, 0x32, 0x00,
-                0x38, 0x40, 0x40, 0x22, 0x7A, 0x00,
-                0x00, 0x7A, 0x0A, 0x0A, 0x72, 0x00,
-                0x7D, 0x0D, 0x19, 0x31, 0x7D, 0x00,
-                0x26, 0x29, 0x29, 0x2F, 0x28, 0x00,
-                0x26, 0x29, 0x29, 0x29, 0x26, 0x00,
-                0x30, 0x48, 0x4D, 0x40, 0x20, 0x00,
-                0x38, 0x08, 0x08, 0x08, 0x08, 0x00,
-                0x08, 0x08, 0x08, 0x08, 0x38, 0x00,
-                0x2F, 0x10, 0xC8, 0xAC, 0xBA, 0x00,
-                0x2F, 0x10, 0x28, 0x34, 0xFA, 0x00,
-                0x00, 0x00, 0x7B, 0x00, 0x00, 0x00,
-                0x08, 0x14, 0x2A, 0x14, 0x22, 0x00,
-                0x22, 0x14, 0x2A, 0x14, 0x08, 0x00,
-                0xAA, 0x00, 0x55, 0x00, 0xAA, 0x00,
-                0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55,
-                0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA,
-                0x00, 0x00, 0x00, 0xFF, 0x00, 0x00,
-                0x10, 0x10, 0x10, 0xFF, 0x00, 0x00,
-                0x14, 0x14, 0x14, 0xFF, 0x00, 0x00,
-                0x10, 0x10, 0xFF, 0x00, 0xFF, 0x00,
-                0x10, 0x10, 0xF0, 0x10, 0xF0, 0x00,
-                0x14, 0x14, 0x14, 0xFC, 0x00, 0x00,
-                0x14, 0x14, 0xF7, 0x00, 0xFF, 0x00,
-                0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00,
-                0x14, 0x14, 0xF4, 0x04, 0xFC, 0x00,
-                0x14, 0x14, 0x17, 0x10, 0x1F, 0x00,
-                0x10, 0x10, 0x1F, 0x10, 0x1F, 0x00,
-                0x14, 0x14, 0x14, 0x1F, 0x00, 0x00,
-                0x10, 0x10, 0x10, 0xF0, 0x00, 0x00,
-                0x00, 0x00, 0x00, 0x1F, 0x10, 0x10,
-                0x10, 0x10, 0x10, 0x1F, 0x10, 0x10,
-                0x10, 0x10, 0x10, 0xF0, 0x10, 0x10,
-                0x00, 0x00, 0x00, 0xFF, 0x10, 0x10,
-                0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
-                0x10, 0x10, 0x10, 0xFF, 0x10, 0x10,
-                0x00, 0x00, 0x00, 0xFF, 0x14, 0x14,
-                0x00, 0x00, 0xFF, 0x00, 0xFF, 0x10,
-                0x00, 0x00, 0x1F, 0x10, 0x17, 0x14,
-                0x00, 0x00, 0xFC, 0x04, 0xF4, 0x14,
-                0x14, 0x14, 0x17, 0x10, 0x17, 0x14,
-                0x14, 0x14, 0xF4, 0x04, 0xF4, 0x14,
-                0x00, 0x00, 0xFF, 0x00, 0xF7, 0x14,
-                0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
-                0x14, 0x14, 0xF7, 0x00, 0xF7, 0x14,
-                0x14, 0x14, 0x14, 0x17, 0x14, 0x14,
-                0x10, 0x10, 0x1F, 0x10, 0x1F, 0x10,
-                0x14, 0x14, 0x14, 0xF4, 0x14, 0x14,
-                0x10, 0x10, 0xF0, 0x10, 0xF0, 0x10,
-                0x00, 0x00, 0x1F, 0x10, 0x1F, 0x10,
-                0x00, 0x00, 0x00, 0x1F, 0x14, 0x14,
-                0x00, 0x00, 0x00, 0xFC, 0x14, 0x14,
-                0x00, 0x00, 0xF0, 0x10, 0xF0, 0x10,
-                0x10, 0x10, 0xFF, 0x10, 0xFF, 0x10,
-                0x14, 0x14, 0x14, 0xFF, 0x14, 0x14,
-                0x10, 0x10, 0x10, 0x1F, 0x00, 0x00,
-                0x00, 0x00, 0x00, 0xF0, 0x10, 0x10,
-                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-                0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
-                0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
-                0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
-                0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F,
-                0x38, 0x44, 0x44, 0x38, 0x44, 0x00,
-                0x7C, 0x2A, 0x2A, 0x3E, 0x14, 0x00,
-                0x7E, 0x02, 0x02, 0x06, 0x06, 0x00,
-                0x02, 0x7E, 0x02, 0x7E, 0x02, 0x00,
-                0x63, 0x55, 0x49, 0x41, 0x63, 0x00,
-                0x38, 0x44, 0x44, 0x3C, 0x04, 0x00,
-                0x40, 0x7E, 0x20, 0x1E, 0x20, 0x00,
-                0x06, 0x02, 0x7E, 0x02, 0x02, 0x00,
-                0x99, 0xA5, 0xE7, 0xA5, 0x99, 0x00,
-                0x1C, 0x2A, 0x49, 0x2A, 0x1C, 0x00,
-                0x4C, 0x72, 0x01, 0x72, 0x4C, 0x00,
-                0x30, 0x4A, 0x4D, 0x4D, 0x30, 0x00,
-                0x30, 0x48, 0x78, 0x48, 0x30, 0x00,
-                0xBC, 0x62, 0x5A, 0x46, 0x3D, 0x00,
-                0x3E, 0x49, 0x49, 0x49, 0x00, 0x00,
-                0x7E, 0x01, 0x01, 0x01, 0x7E, 0x00,
-                0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x00,
-                0x44, 0x44, 0x5F, 0x44, 0x44, 0x00,
-                0x40, 0x51, 0x4A, 0x44, 0x40, 0x00,
-                0x40, 0x44, 0x4A, 0x51, 0x40, 0x00,
-                0x00, 0x00, 0xFF, 0x01, 0x03, 0x00,
-                0xE0, 0x80, 0xFF, 0x00, 0x00, 0x00,
-                0x08, 0x08, 0x6B, 0x6B, 0x08, 0x08,
-                0x36, 0x12, 0x36, 0x24, 0x36, 0x00,
-                0x06, 0x0F, 0x09, 0x0F, 0x06, 0x00,
-                0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
-                0x00, 0x00, 0x10, 0x10, 0x00, 0x00,
-                0x30, 0x40, 0xFF, 0x01, 0x01, 0x00,
-                0x00, 0x1F, 0x01, 0x01, 0x1E, 0x00,
-                0x00, 0x19, 0x1D, 0x17, 0x12, 0x00,
-                0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00,
-                0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-                } ;
+const unsigned char     PAL_gratPattern[] =
+        {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,        // none
+#ifdef PAL_GRAT
+        0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x80,        // dots
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x91,        // line
+        0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xd5,        // axis
+        0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f         // cursor
+#endif
+        } ;
+
+/*
+ * the glyph tables PAL_charIndex and PAL_charTable are in PAL_assets.c,
+ * written by tools/PAL_assets.cpp with the chars the firmware uses only
+ */
+
+/*
+ * 3 pixels doubled to 6, for double width chars
+ */
+const unsigned char     PAL_charDouble[8] =
+        {
+        0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f
+        } ;
 
 /*********************
  * LIBRARY FUNCTIONS
@@ -460,6 +462,8 @@ const unsigned char     PAL_charTable[] = {
  ***********************************/
 void    PAL_ISR()
         {
+        PROF_ISR_BEGIN ;
+
         if(INTCON.TMR0IF)
                 {
                 unsigned char d ;      // temporary register to save TABLAT
@@ -478,14 +482,11 @@ void    PAL_ISR()
 
                         /*
                          * start of video line
+                         * horizontal sync is timed by TIMER 2, the line is
+                         * prepared during the pulse
                          */
+                        PAL_SYNC_START(PAL_THSYNC) ;
 
-                        PAL_HSYNC(3) ;          // horizontal sync : low level
-                        PAL_BSYNC = 1 ;         // ultra black
-
-                        /*
-                         * during ultra black level :
-                         */
                         PAL_lineVideo++ ;               // next line number
                         if(PAL_lineVideo == 287)        // last line ?
                                 {
@@ -497,7 +498,19 @@ void    PAL_ISR()
                         /*
                          * points to the first 8 pixels of the line
                          */
+#ifdef PAL_TEXT
+                        ptr = PAL_textShow ;                                    // text area
+#else
                         ptr = PAL_screen + (((PAL_lineVideo - PAL_shift_y) & 0b11111110) << 3) ;
+#endif
+#ifdef PAL_VECTOR
+                        if(PAL_lineVideo >= PAL_vecStart) ptr = PAL_vecLine ;   // vector area
+#endif
+
+                        while(!PIR1.TMR2IF) ;           // end of horizontal sync
+                        T2CON.TMR2ON = 0 ;
+                        PIR1.TMR2IF = 0 ;
+                        PAL_BSYNC = 1 ;                 // ultra black
 
                         /*
                          * make left border
@@ -537,16 +550,89 @@ void    PAL_ISR()
 
                                 PAL_MAKE_BORDER ;                       // make right border
                                 }
+
+#ifdef PAL_VECTOR
+                        /*
+                         * the vector line is cleared and its first row is built on top
+                         * of the field, out of the picture, next rows are built after
+                         * the second video line of the previous row.
+                         */
+                        if(PAL_lineVideo == 1)
+                                {
+                                unsigned char   i ;
+
+                                if(PAL_vecSwap)                 // new list
+                                        {
+                                        PAL_vecFront ^= 1 ;
+                                        PAL_vecSwap = 0 ;
+                                        }
+                                PAL_vecPtr = PAL_vecPool[PAL_vecFront] ;
+                                PAL_vecCnt = PAL_vecCount[PAL_vecFront] ;
+                                for(i = 0 ; i < PAL_X / 8 ; i++) PAL_vecLine[i] = 0 ;
+                                PAL_vecLeft = PAL_vecRows ;
+                                }
+                        else if(PAL_vecLeft)
+                                {
+                                if((PAL_lineVideo == 2)
+                                        || ((PAL_lineVideo > PAL_vecStart) && ((PAL_lineVideo - PAL_shift_y) & 1)))
+                                        {
+                                        PAL_VEC_APPLY ;
+                                        PAL_vecLeft-- ;
+                                        }
+                                }
+#endif
+
+#ifdef PAL_GRAT
+                        /*
+                         * no overlay above the vector area, the overlay of a row is
+                         * picked before its first video line
+                         */
+                        if(PAL_lineVideo == 1)
+                                {
+                                PAL_gratPtr = PAL_gratPattern ;
+                                PAL_gratRow = PAL_vecTop ;
+                                PAL_gratCnt = PAL_gratFirst ;
+                                }
+                        else if((PAL_lineVideo + 1 >= PAL_vecStart) && (PAL_lineVideo + 1 < PAL_max_y)
+                                && ((PAL_lineVideo - PAL_shift_y) & 1))
+                                {
+                                PAL_GRAT_NEXT ;
+                                }
+#endif
+
+#ifdef PAL_TEXT
+                        /*
+                         * first text pixel line is built on top of field,
+                         * next ones during the two video lines of the previous one
+                         */
+                        if(PAL_lineVideo == 1)
+                                {
+                                PAL_textRow = 0 ;
+                                PAL_textHalf = 0 ;
+                                }
+                        if((PAL_lineVideo <= 2)
+                                || ((PAL_lineVideo >= PAL_shift_y) && (PAL_lineVideo + 2 < PAL_vecStart)))
+                                {
+                                PAL_TEXT_BUILD ;
+                                }
+#endif
                         }
                 else
                         {
                         /*
                          * vertical synchronization
-                         * decode the PAL_lineCode and build the 4 parts of the sync line
+                         * the PAL_lineCode parts are output by PAL_SYNC_PARTS, here and
+                         * from the TIMER 2 interrupt, info lines only have a 4 us pulse
                          */
-                        PAL_BSYNC = (PAL_lineCode & 1) ? 1 : 0 ;        // first part
-                        if(PAL_lineCode & 2) Delay_us(PAL_DELAY4) ; else Delay_us(PAL_DELAY28 - 6) ;
+                        PAL_syncCode = PAL_lineCode ;
+                        PAL_syncLeft = (PAL_lineCode == PAL_LINFO) ? 2 : 4 ;
+                        PAL_SYNC_START((PAL_lineCode & 2) ? PAL_T4 : PAL_T28) ;
+                        PAL_SYNC_PARTS(0) ;
 
+                        /*
+                         * the next steps are done during a 28 us part,
+                         * or after the pulse of an info line
+                         */
                         PAL_linePtr++ ;
                         PAL_lineIdx++ ;
                         PAL_lineVideo = 0 ;
@@ -558,17 +644,15 @@ void    PAL_ISR()
                                 PAL_lineIdx = 0 ;               // back to start
                                 PAL_linePtr = PAL_ltype ;
                                 PAL_frameCtr++ ;
+                                PAL_vblank = 1 ;
                                 }
 
-                        PAL_BSYNC = (PAL_lineCode & 4) ? 1 : 0 ;        // second part
-                        if(PAL_lineCode != PAL_LINFO)
+                        /*
+                         * new frame : the hook runs during the second part of the line
+                         */
+                        if((PAL_lineIdx == 0) && PAL_vblankHook)
                                 {
-                                if(PAL_lineCode & 8) Delay_us(PAL_DELAY4) ; else Delay_us(PAL_DELAY28) ;
-
-                                PAL_BSYNC = (PAL_lineCode & 16) ? 1 : 0 ;       // third part
-                                if(PAL_lineCode & 32) Delay_us(PAL_DELAY4) ; else Delay_us(PAL_DELAY28) ;
-
-                                PAL_BSYNC = (PAL_lineCode & 64) ? 1 : 0 ;       // fourth part (no delay is needed)
+                                PAL_vblankHook() ;
                                 }
 
                         }
@@ -577,6 +661,14 @@ void    PAL_ISR()
 
                 INTCON.TMR0IF = 0 ;     //      clear TIMER 0 interrupt flag
                 }
+
+        if(PIR1.TMR2IF)                 // end of a 28 us part of a sync line
+                {
+                PIR1.TMR2IF = 0 ;
+                PAL_SYNC_PARTS(1) ;
+                }
+
+        PROF_ISR_END ;
         }
 
 /************************************************************
@@ -592,7 +684,8 @@ void    PAL_ISR()
  *      the PIC MUST be clocked at 32 Mhz
  * notes :
  *      this function must be called to prepare for PAL video generation
- *      this function takes control of TIMER 0 and associated interrupt
+ *      this function takes control of TIMER 0, TIMER 2 and associated interrupts,
+ *      both are high priority
  */
 void    PAL_init(unsigned char y)
         {
@@ -601,9 +694,21 @@ void    PAL_init(unsigned char y)
 
         T0CON = 0b11000000 ;    // TIMER 0 is 8 bits, prescaler = 2
 
+        T2CON = 0 ;             // TIMER 2 : prescaler = 1, postscaler = 1, stopped
+        PR2 = 0xff ;
+        IPR1.TMR2IP = 1 ;       // sync pulses are high priority
+        PIR1.TMR2IF = 0 ;
+        PIE1.TMR2IE = 1 ;
+
         PAL_y = y ;                     // save vertical definition
         PAL_shift_y = 286 / 2 - y ;     // compute vertical offset for centering
-        PAL_max_y = y * 2 + PAL_shift_y ;       // compute last video line number
+        PAL_max_y = (unsigned int)y * 2 + PAL_shift_y ;       // compute last video line number
+        PAL_mapY = y ;                  // all rows are in PAL_screen
+#ifdef PAL_VECTOR
+        PAL_vecStart = PAL_max_y ;      // no vector area
+        PAL_vecRows = 0 ;
+#endif
+        PAL_gratPtr = PAL_gratPattern ; // no overlay
         }
 
 /**********************************************
@@ -633,6 +738,7 @@ void    PAL_control(unsigned char st, unsigned char rd)
         PAL_render = rd ;
         }
 
+#ifndef PAL_TEXT
 /************************************************
  * PAL_fill : fill video screen with pattern
  * parameters :
@@ -647,7 +753,76 @@ void    PAL_control(unsigned char st, unsigned char rd)
  */
 void    PAL_fill(unsigned char c)
         {
-        memset(PAL_screen, c, PAL_X * PAL_y / 8) ;
+        memset(PAL_screen, c, PAL_X * PAL_mapY / 8) ;
+        }
+#endif
+
+/**********************************************
+ * PAL_vblankWait : wait for the next frame
+ * parameters :
+ *      none
+ * returns :
+ *      nothing
+ * requires :
+ *      video must be running
+ * notes :
+ *      returns at the end of the vertical sync, when PAL_frameCtr changes,
+ *      there are then PAL_vblankCycles() instruction cycles before the
+ *      ISR shows the first picture line : text cells and PAL_screen
+ *      written in this time are never shown half updated.
+ *      one call per main loop locks it to 25 frames per second.
+ */
+void    PAL_vblankWait()
+        {
+        PAL_vblank = 0 ;
+        while(!PAL_vblank) ;
+        }
+
+/**********************************************
+ * PAL_setVblank : set the new frame hook
+ * parameters :
+ *      hook : function called on each new frame, 0 for none
+ * returns :
+ *      nothing
+ * requires :
+ *      nothing
+ * notes :
+ *      the hook runs in PAL_ISR, during a 28 us part of the last sync
+ *      line : it must return within about 150 cycles and must not
+ *      call functions the main loop calls.
+ */
+void    PAL_setVblank(void (*hook)())
+        {
+        unsigned char   ie ;
+
+        ie = INTCON.T0IE ;              // pointer is read by PAL_ISR
+        INTCON.T0IE = 0 ;
+        PAL_vblankHook = hook ;
+        INTCON.T0IE = ie ;
+        }
+
+/**********************************************
+ * PAL_vblankCycles : free time of the vertical blank
+ * parameters :
+ *      none
+ * returns :
+ *      instruction cycles left to the main loop between PAL_vblankWait
+ *      (or the hook) and the first picture line
+ * requires :
+ *      PAL_init must have been called
+ * notes :
+ *      estimated from the ISR time of blank lines, with 104 rows
+ *      about 18600 cycles (2.3 ms)
+ */
+unsigned long   PAL_vblankCycles()
+        {
+        unsigned long   c ;
+
+        c = (unsigned long)PAL_INFO_LINES * (PAL_LINE_CYCLES - PAL_INFO_ISR) ;
+        c += (unsigned long)(PAL_shift_y - 1) * (PAL_LINE_CYCLES - PAL_BLANK_ISR) ;
+        c -= PAL_TOP_ISR ;
+
+        return(c) ;
         }
 
 /**********************************************
@@ -666,6 +841,258 @@ void    PAL_setBorder(unsigned char border)
         PAL_border = border ;
         }
 
+#ifdef PAL_VECTOR
+/**********************************************
+ * PAL_vecInit : set vector area
+ * parameters :
+ *      top : first row of the vector area, rows above it are in PAL_screen,
+ *              or text cells if PAL_TEXT is defined
+ * returns :
+ *      nothing
+ * requires :
+ *      PAL_init must have been called, video must be stopped
+ * notes :
+ *      PAL_screen only needs PAL_X * top / 8 bytes, the vector area is
+ *      drawn from the column spans PAL_vecLo and PAL_vecHi
+ *      at most PAL_VEC_ROWS rows, top is raised if needed
+ */
+void    PAL_vecInit(unsigned char top)
+        {
+        if(PAL_y - top > PAL_VEC_ROWS) top = PAL_y - PAL_VEC_ROWS ;
+#ifdef PAL_TEXT
+        if(top > PAL_TEXT_ROWS * 8) top = PAL_TEXT_ROWS * 8 ;
+#endif
+
+        PAL_vecTop = top ;
+        PAL_vecRows = PAL_y - top ;
+        PAL_vecStart = PAL_shift_y + 2 * (unsigned int)top ;
+#ifdef PAL_TEXT
+        memset(PAL_text, 0, sizeof(PAL_text)) ;         // glyph 0 is space
+#else
+        PAL_mapY = top ;                // drawing functions are clipped to PAL_screen
+#endif
+
+        memset(PAL_vecLo, 0xff, PAL_X) ;        // empty columns
+        memset(PAL_vecHi, 0, PAL_X) ;
+        memset(PAL_vecCount, 0, sizeof(PAL_vecCount)) ;
+        }
+
+/**********************************************
+ * PAL_vecCommit : put the column spans on screen
+ * parameters :
+ *      none
+ * returns :
+ *      nothing
+ * requires :
+ *      PAL_vecInit must have been called, video must be running
+ * notes :
+ *      column x is lit from row PAL_vecLo[x] to row PAL_vecHi[x],
+ *      PAL_vecLo[x] > PAL_vecHi[x] for an empty column.
+ *      spans are clipped in place.
+ *      waits until the previous spans are on screen.
+ *
+ *      a column is an event on its first row and another one after its
+ *      last row. events are sorted by row (counting sort) into the back
+ *      list, then events of the same row and byte are merged in place
+ *      into one token : a row has at most 16 tokens, the list is never
+ *      longer than the events.
+ */
+void    PAL_vecCommit()
+        {
+        unsigned char   *pool, *cnt ;
+        unsigned char   x, v, n, m, t, lo, hi, first, idx, mask ;
+        unsigned int    k, j ;
+
+        while(PAL_vecSwap) ;            // back list is still waiting for the ISR
+
+        pool = PAL_vecPool[PAL_vecFront ^ 1] ;
+        cnt = PAL_vecCount[PAL_vecFront ^ 1] ;
+
+        /*
+         * clip spans to the vector area, count events per row
+         * PAL_vecHi becomes the row after the span
+         */
+        memset(cnt, 0, PAL_vecRows) ;
+        for(x = 0 ; x < PAL_X ; x++)
+                {
+                lo = PAL_vecLo[x] ;
+                hi = PAL_vecHi[x] ;
+                if(lo < PAL_vecTop) lo = PAL_vecTop ;
+                if(hi >= PAL_y) hi = PAL_y - 1 ;
+                if(lo > hi)
+                        {
+                        PAL_vecLo[x] = 0xff ;
+                        continue ;
+                        }
+                lo -= PAL_vecTop ;
+                hi -= (unsigned char)(PAL_vecTop - 1) ;
+                PAL_vecLo[x] = lo ;
+                PAL_vecHi[x] = hi ;
+                cnt[lo]++ ;
+                if(hi < PAL_vecRows) cnt[hi]++ ;
+                }
+
+        /*
+         * first event of each row, modulo 256 : a row has at most 128 events
+         */
+        first = 0 ;
+        for(v = 0 ; v < PAL_vecRows ; v++)
+                {
+                n = cnt[v] ;
+                cnt[v] = first ;
+                first += n ;
+                }
+
+        /*
+         * events are the column numbers, sorted by row then by column
+         * cnt[v] becomes the first event of row v + 1
+         */
+        for(x = 0 ; x < PAL_X ; x++)
+                {
+                lo = PAL_vecLo[x] ;
+                if(lo == 0xff) continue ;
+                pool[cnt[lo]++] = x ;
+                hi = PAL_vecHi[x] ;
+                if(hi < PAL_vecRows) pool[cnt[hi]++] = x ;
+                }
+
+        /*
+         * merge events of the same byte into tokens, a token is not
+         * longer than its events : j never passes k
+         */
+        k = 0 ;
+        j = 0 ;
+        first = 0 ;
+        for(v = 0 ; v < PAL_vecRows ; v++)
+                {
+                n = cnt[v] - first ;    // events of row v
+                first = cnt[v] ;
+                t = 0 ;
+                while(n)
+                        {
+                        x = pool[k] ;
+                        idx = x >> 3 ;
+                        mask = PAL_vecBit[x & 7] ;
+                        m = 1 ;
+                        while((m < n) && ((pool[k + m] >> 3) == idx))
+                                {
+                                mask |= PAL_vecBit[pool[k + m] & 7] ;
+                                m++ ;
+                                }
+                        k += m ;
+                        n -= m ;
+
+                        if(m == 1)
+                                {
+                                pool[j++] = x ;
+                                }
+                        else if(mask == 0xff)
+                                {
+                                pool[j++] = PAL_VEC_FULL + idx ;
+                                }
+                        else
+                                {
+                                pool[j++] = PAL_VEC_MASK + idx ;
+                                pool[j++] = mask ;
+                                }
+                        t++ ;
+                        }
+                cnt[v] = t ;
+                }
+
+        PAL_vecSwap = 1 ;               // on screen from next field
+        }
+
+#ifdef PAL_TEXT
+/**********************************************
+ * PAL_textWrite : write a string in text cells
+ * parameters :
+ *      row, col : cell of the first char
+ *      s : string to write
+ * returns :
+ *      nothing
+ * requires :
+ *      PAL_vecInit must have been called
+ * notes :
+ *      no automatic carriage return, the string is cut at end of row.
+ *      on screen from the next video field.
+ */
+void    PAL_textWrite(unsigned char row, unsigned char col, char *s)
+        {
+        unsigned char   *cell ;
+        unsigned char   c ;
+
+        if(row >= PAL_TEXT_ROWS) return ;
+
+        cell = PAL_text + row * PAL_TEXT_COLS + col ;
+        while((c = *s++) && (col < PAL_TEXT_COLS))
+                {
+                *cell++ = PAL_GLYPH(c) ;        // the ISR copies glyph lines as they are
+                col++ ;
+                }
+        }
+#endif
+
+#ifdef PAL_GRAT
+/**********************************************
+ * PAL_gratInit : set graticule of the vector area
+ * parameters :
+ *      center : row of the horizontal axis
+ *      div : rows per vertical division, 0 for no graticule
+ * returns :
+ *      nothing
+ * requires :
+ *      PAL_vecInit must have been called
+ * notes :
+ *      horizontal divisions are dotted lines every div rows from center,
+ *      the axis is dotted twice as dense, vertical divisions are dots every
+ *      16 pixels on one row out of two.
+ *      the graticule is ORed with the vector area by PAL_ISR, it costs
+ *      neither PAL_screen bytes nor drawing time.
+ *      the current field may show a partial grid.
+ */
+void    PAL_gratInit(unsigned char center, unsigned char div)
+        {
+        unsigned char   first ;
+
+        first = 0 ;
+        if(div)
+                {
+                if(center >= PAL_vecTop) first = (unsigned char)(center - PAL_vecTop) % div ;
+                else first = (unsigned char)(div - (unsigned char)(PAL_vecTop - center) % div) % div ;
+                }
+
+        PAL_gratCenter = center ;
+        PAL_gratFirst = first ;
+        PAL_gratDiv = div ;
+        }
+
+/**********************************************
+ * PAL_gratCursor : set a horizontal cursor
+ * parameters :
+ *      n : cursor number [0;PAL_GRAT_CURSORS-1]
+ *      y : row of the cursor, PAL_GRAT_OFF to hide it
+ * returns :
+ *      nothing
+ * requires :
+ *      nothing
+ * notes :
+ *      cursors are dashed lines over the vector area, for the trigger
+ *      level for example. on screen from the next row drawn by PAL_ISR.
+ */
+void    PAL_gratCursor(unsigned char n, unsigned char y)
+        {
+        if(n >= PAL_GRAT_CURSORS) return ;
+
+        PAL_gratMark[n] = y ;
+        }
+#endif
+#endif
+
+/*
+ * drawing functions, there is no PAL_screen with PAL_TEXT
+ */
+#ifndef PAL_TEXT
 /********************************************
  * PAL_setPixel : direct access to pixel
  * parameters :
@@ -687,10 +1114,8 @@ void    PAL_setPixel(char x, char y, unsigned char mode)
         /*
          * do nothing if pixel is out of bounds
          */
-        if(x < 0) return ;
-        if(y < 0) return ;
         if(x >= PAL_X) return ;
-        if(y >= PAL_y) return ;
+        if(y >= PAL_mapY) return ;
 
         ptr = PAL_screen + (((y << 7) + x) >> 3) ;      // points to byte in screen map
         mask = 1 << (x & 7) ;                           // pixel bit mask
@@ -709,6 +1134,176 @@ void    PAL_setPixel(char x, char y, unsigned char mode)
                 }
         }
 
+/*
+ * span drawing : a color mode is a pair of or / xor masks (o, t),
+ * pixels of mask m in byte b become (b | (m & o)) ^ (m & t),
+ * so kernels need no switch in their loops
+ */
+#define PAL_SPAN(ptr, m, o, t)  *(ptr) = (*(ptr) | ((m) & (o))) ^ ((m) & (t))
+
+/********************************************
+ * PAL_spanMasks : or and xor masks of a color mode
+ */
+static void     PAL_spanMasks(unsigned char mode, unsigned char *o, unsigned char *t)
+        {
+        switch(mode)
+                {
+                case PAL_COLOR_BLACK:
+                        *o = 0xff ;                     // set then toggle : clear
+                        *t = 0xff ;
+                        break ;
+                case PAL_COLOR_WHITE:
+                        *o = 0xff ;                     // set
+                        *t = 0 ;
+                        break ;
+                default:
+                        *o = 0 ;                        // toggle
+                        *t = 0xff ;
+                        break ;
+                }
+        }
+
+/********************************************
+ * PAL_vline : draw a vertical span
+ * parameters :
+ *      x : pixel row
+ *      y0, y1 : pixel start and end columns, in any order
+ *      pcolor : PAL_COLOR_WHITE or PAL_COLOR_BLACK or PAL_COLOR_REVERSE
+ * returns :
+ *      nothing
+ * requires :
+ *      PAL_init must have been called
+ * notes :
+ *      clipped once, then one byte every PAL_X / 8 bytes with the same mask
+ */
+void    PAL_vline(char x, char y0, char y1, unsigned char pcolor)
+        {
+        unsigned char   *ptr ;
+        unsigned char   mask, n ;
+
+        if(y0 > y1)
+                {
+                n = y0 ;
+                y0 = y1 ;
+                y1 = n ;
+                }
+
+        /*
+         * clipping
+         */
+        if(x >= PAL_X) return ;
+        if(y0 >= PAL_mapY) return ;
+        if(y1 >= PAL_mapY) y1 = PAL_mapY - 1 ;
+
+        ptr = PAL_screen + ((unsigned int)y0 << 4) + (x >> 3) ;
+        mask = 1 << (x & 7) ;
+        n = (unsigned char)(y1 - y0 + 1) ;
+
+        switch(pcolor)
+                {
+                case PAL_COLOR_BLACK:
+                        mask = ~mask ;
+                        do
+                                {
+                                *ptr &= mask ;
+                                ptr += PAL_X / 8 ;
+                                }
+                        while(--n) ;
+                        break ;
+                case PAL_COLOR_WHITE:
+                        do
+                                {
+                                *ptr |= mask ;
+                                ptr += PAL_X / 8 ;
+                                }
+                        while(--n) ;
+                        break ;
+                default:
+                        do
+                                {
+                                *ptr ^= mask ;
+                                ptr += PAL_X / 8 ;
+                                }
+                        while(--n) ;
+                        break ;
+                }
+        }
+
+/********************************************
+ * PAL_hline : draw a horizontal span
+ * parameters :
+ *      x0, x1 : pixel start and end rows, in any order
+ *      y : pixel column
+ *      pcolor : PAL_COLOR_WHITE or PAL_COLOR_BLACK or PAL_COLOR_REVERSE
+ * returns :
+ *      nothing
+ * requires :
+ *      PAL_init must have been called
+ * notes :
+ *      clipped once, partial bytes at both ends are masked,
+ *      whole bytes in between are written by memset
+ */
+void    PAL_hline(char x0, char x1, char y, unsigned char pcolor)
+        {
+        unsigned char   *ptr ;
+        unsigned char   lmask, rmask, o, t, n ;
+
+        if(x0 > x1)
+                {
+                n = x0 ;
+                x0 = x1 ;
+                x1 = n ;
+                }
+
+        /*
+         * clipping
+         */
+        if(y >= PAL_mapY) return ;
+        if(x0 >= PAL_X) return ;
+        if(x1 >= PAL_X) x1 = PAL_X - 1 ;
+
+        ptr = PAL_screen + ((unsigned int)y << 4) + (x0 >> 3) ;
+        lmask = 0xff << (x0 & 7) ;              // pixels from x0 to the end of its byte
+        rmask = 0xff >> (7 - (x1 & 7)) ;        // pixels from the start of x1 byte to x1
+        n = (x1 >> 3) - (x0 >> 3) ;             // bytes after the first one
+
+        PAL_spanMasks(pcolor, &o, &t) ;
+
+        if(n == 0)                              // span inside a single byte
+                {
+                lmask &= rmask ;
+                PAL_SPAN(ptr, lmask, o, t) ;
+                return ;
+                }
+
+        PAL_SPAN(ptr, lmask, o, t) ;
+        ptr++ ;
+
+        /*
+         * whole bytes
+         */
+        n-- ;
+        if(n)
+                {
+                if(pcolor == PAL_COLOR_REVERSE)
+                        {
+                        do
+                                {
+                                *ptr ^= 0xff ;
+                                ptr++ ;
+                                }
+                        while(--n) ;
+                        }
+                else
+                        {
+                        memset(ptr, (pcolor == PAL_COLOR_WHITE) ? 0xff : 0, n) ;
+                        ptr += n ;
+                        }
+                }
+
+        PAL_SPAN(ptr, rmask, o, t) ;
+        }
+
 /******************************
  * PAL_line : draw a line
  * parameters :
@@ -721,12 +1316,30 @@ void    PAL_setPixel(char x, char y, unsigned char mode)
  *      PAL_init must have been called
  * notes :
  *      uses Bresenham's line drawing algorithm
+ *      vertical and horizontal lines are drawn as spans.
+ *      when both ends are on screen, the screen pointer and the pixel mask
+ *      follow the line without bounds checks, otherwise each pixel is
+ *      clipped by PAL_setPixel.
  */
 void PAL_line(char x0, char y0, char x1, char y1, unsigned char pcolor)
         {
         int     dy ;
         int     dx ;
         int     stepx, stepy ;
+        unsigned char   *ptr ;
+        unsigned char   mask, o, t ;
+        signed char     stepp ;
+
+        if(x0 == x1)
+                {
+                PAL_vline(x0, y0, y1, pcolor) ;
+                return ;
+                }
+        if(y0 == y1)
+                {
+                PAL_hline(x0, x1, y0, pcolor) ;
+                return ;
+                }
 
         dy = y1 - y0 ;
         dx = x1 - x0 ;
@@ -754,7 +1367,59 @@ void PAL_line(char x0, char y0, char x1, char y1, unsigned char pcolor)
         dy <<= 1 ;
         dx <<= 1 ;
 
-        PAL_setPixel(x0, y0, pcolor) ;
+        if((x0 >= PAL_X) || (x1 >= PAL_X) || (y0 >= PAL_mapY) || (y1 >= PAL_mapY))
+                {
+                /*
+                 * partly out of screen : clip each pixel
+                 */
+                PAL_setPixel(x0, y0, pcolor) ;
+
+                if(dx > dy)
+                        {
+                        int fraction;
+                        fraction = dy - (dx >> 1) ;
+
+                        while(x0 != x1)
+                                {
+                                if(fraction >= 0)
+                                        {
+                                        y0 = (char)(y0 + stepy) ;
+                                        fraction -= dx ;
+                                        }
+                                x0 = (char)(x0 + stepx) ;
+                                fraction += dy ;
+                                PAL_setPixel(x0, y0, pcolor) ;
+                                }
+                        }
+                else
+                        {
+                        int fraction;
+                        fraction = dx - (dy >> 1) ;
+
+                        while(y0 != y1)
+                                {
+                                if(fraction >= 0)
+                                        {
+                                        x0 = (char)(x0 + stepx) ;
+                                        fraction -= dy ;
+                                        }
+                                y0 = (char)(y0 + stepy) ;
+                                fraction += dx ;
+                                PAL_setPixel(x0, y0, pcolor) ;
+                                }
+                        }
+                return ;
+                }
+
+        /*
+         * on screen : incremental pointer and mask
+         */
+        ptr = PAL_screen + ((unsigned int)y0 << 4) + (x0 >> 3) ;
+        mask = 1 << (x0 & 7) ;
+        stepp = (stepy > 0) ? PAL_X / 8 : -(PAL_X / 8) ;
+        PAL_spanMasks(pcolor, &o, &t) ;
+
+        PAL_SPAN(ptr, mask, o, t) ;
 
         if(dx > dy)
                 {
@@ -765,12 +1430,30 @@ void PAL_line(char x0, char y0, char x1, char y1, unsigned char pcolor)
                         {
                         if(fraction >= 0)
                                 {
-                                y0 += stepy ;
+                                ptr += stepp ;
                                 fraction -= dx ;
                                 }
-                        x0 += stepx ;
+                        x0 = (char)(x0 + stepx) ;
+                        if(stepx > 0)
+                                {
+                                mask <<= 1 ;
+                                if(mask == 0)
+                                        {
+                                        mask = 0x01 ;
+                                        ptr++ ;
+                                        }
+                                }
+                        else
+                                {
+                                mask >>= 1 ;
+                                if(mask == 0)
+                                        {
+                                        mask = 0x80 ;
+                                        ptr-- ;
+                                        }
+                                }
                         fraction += dy ;
-                        PAL_setPixel(x0, y0, pcolor) ;
+                        PAL_SPAN(ptr, mask, o, t) ;
                         }
                 }
         else
@@ -782,12 +1465,30 @@ void PAL_line(char x0, char y0, char x1, char y1, unsigned char pcolor)
                         {
                         if(fraction >= 0)
                                 {
-                                x0 += stepx ;
+                                if(stepx > 0)
+                                        {
+                                        mask <<= 1 ;
+                                        if(mask == 0)
+                                                {
+                                                mask = 0x01 ;
+                                                ptr++ ;
+                                                }
+                                        }
+                                else
+                                        {
+                                        mask >>= 1 ;
+                                        if(mask == 0)
+                                                {
+                                                mask = 0x80 ;
+                                                ptr-- ;
+                                                }
+                                        }
                                 fraction -= dy ;
                                 }
-                        y0 += stepy ;
+                        y0 = (char)(y0 + stepy) ;
+                        ptr += stepp ;
                         fraction += dx ;
-                        PAL_setPixel(x0, y0, pcolor) ;
+                        PAL_SPAN(ptr, mask, o, t) ;
                         }
                 }
         }
@@ -815,14 +1516,14 @@ void PAL_circle(char x, char y, char r, unsigned char pcolor)
                 /*
                  * pixel row
                  */
-                px = (long)sinE3(a) * r ;
+                px = (long)sinE3((unsigned int)a) * r ;
                 px /= 1000 ;
                 px += x ;
 
                 /*
                  * pixel column
                  */
-                py = (long)cosE3(a) * r ;
+                py = (long)cosE3((unsigned int)a) * r ;
                 py /= 1000 ;
                 py += y ;
 
@@ -831,7 +1532,7 @@ void PAL_circle(char x, char y, char r, unsigned char pcolor)
                  */
                 if(a > 0)
                         {
-                        PAL_line(opx, opy, px, py, pcolor) ;    // draw the line from old to new coordinates
+                        PAL_line((char)opx, (char)opy, (char)px, (char)py, pcolor) ;    // draw the line from old to new coordinates
                         }
                 opx = px ;      // save previous coordinates
                 opy = py ;
@@ -849,18 +1550,45 @@ void PAL_circle(char x, char y, char r, unsigned char pcolor)
  * requires :
  *      PAL_init must have been called
  * notes :
- *      none
+ *      right column x1 is excluded, rows are drawn as horizontal spans
  */
 void PAL_box(char x0, char y0, char x1, char y1, unsigned char pcolor)
         {
+        char            y ;
+        unsigned char   n ;
+
+        /*
+         * right column x1 is excluded
+         */
+        if(x0 == x1) return ;
+        if(x0 > x1)
+                {
+                y = x0 ;
+                x0 = x1 ;
+                x1 = y ;
+                }
+        x1-- ;
+
+        if(y0 > y1)
+                {
+                y = y0 ;
+                y0 = y1 ;
+                y1 = y ;
+                }
+
         /*
-         * just draw lines from left to right
+         * clip rows once, each row is a horizontal span
          */
-        while(x0 != x1)
+        if(y0 >= PAL_mapY) return ;
+        if(y1 >= PAL_mapY) y1 = PAL_mapY - 1 ;
+
+        n = (unsigned char)(y1 - y0 + 1) ;
+        do
                 {
-                PAL_line(x0, y0, x0, y1, pcolor) ;
-                x0++ ;
+                PAL_hline(x0, x1, y0, pcolor) ;
+                y0++ ;
                 }
+        while(--n) ;
         }
 
 /************************************
@@ -887,6 +1615,20 @@ void PAL_rectangle(char x0, char y0, char x1, char y1, unsigned char pcolor)
         PAL_line(x0, y1, x0, y0, pcolor) ;
         }
 
+/*
+ * PAL_GLYPH_ROW : write the 6 pixels row pattern p into bytes ptr[0] and ptr[1]
+ * sh is 1 << (x & 7) : the 8x8 bits hardware multiplier does the shift,
+ * ml and mh are the masks of the pixels to keep, mh is 0xff when
+ * the 6 pixels fit in ptr[0]
+ */
+#define PAL_GLYPH_ROW(ptr, p, sh, ml, mh)                                       \
+        {                                                                       \
+        unsigned int    w ;                                                     \
+        w = (unsigned char)(p) * (unsigned char)(sh) ;                          \
+        (ptr)[0] = ((ptr)[0] & (ml)) | (unsigned char)w ;                       \
+        if((mh) != 0xff) (ptr)[1] = ((ptr)[1] & (mh)) | (unsigned char)(w >> 8) ; \
+        }
+
 /********************************
  * PAL_char : draw a character
  * parameters :
@@ -899,14 +1641,20 @@ void PAL_rectangle(char x0, char y0, char x1, char y1, unsigned char pcolor)
  *      PAL_init must have been called
  * notes :
  *      char is white on black background, please use PAL_box to reverse after PAL_char if you want to reverse video.
+ *      PAL_CHAR_STANDARD, DWIDTH, DHEIGHT and DSIZE chars inside the screen
+ *      are written one whole pixel line at a time, other sizes and chars
+ *      crossing the screen border are drawn pixel by pixel.
  */
 void    PAL_char(unsigned char x, unsigned char y, unsigned char c, unsigned char size)
         {
         unsigned char   i, j ;
-        unsigned char   px, py ;
         unsigned char   sx, sy ;
         unsigned char   mx, my ;
-        const char *ptr ;
+        unsigned char   p, sh, ml, mh ;
+        unsigned char   sh2, ml2, mh2 ;
+        unsigned int    m ;
+        unsigned char   *scr, *scr2 ;
+        const unsigned char *ptr ;
 
         /*
          * get height and width size
@@ -917,32 +1665,98 @@ void    PAL_char(unsigned char x, unsigned char y, unsigned char c, unsigned cha
         /*
          * pointer to pattern in character table
          */
-        ptr = PAL_charTable + c * 6 ;
+        ptr = PAL_charTable + ((unsigned int)PAL_GLYPH(c) << 3) ;
 
-        /*
-         * char is 6 pixels large
-         */
-        for(i = 0 ; i < 6 ; i++)
+        if((mx > 2) || (my > 2)
+                || ((unsigned int)x + 6 * mx > PAL_X) || ((unsigned int)y + 8 * my > PAL_mapY))
                 {
-                px = x + i * mx ;
-                c = *ptr++ ;    // get byte pattern
-                py = y ;
-
                 /*
-                 * char is 8 pixels high
+                 * char is 8 pixels high and 6 pixels large
                  */
                 for(j = 0 ; j < 8 ; j++)
                         {
-                        for(sx = 0 ; sx < mx ; sx++)
+                        p = *ptr++ ;    // get line pattern
+                        for(i = 0 ; i < 6 ; i++)
                                 {
-                                for(sy = 0 ; sy < my ; sy++)
+                                for(sx = 0 ; sx < mx ; sx++)
                                         {
-                                        PAL_setPixel(px + sx, py + sy, c & 1) ;        // paint pixel
+                                        for(sy = 0 ; sy < my ; sy++)
+                                                {
+                                                PAL_setPixel((char)(x + i * mx + sx), (char)(y + j * my + sy), p & 1) ;        // paint pixel
+                                                }
                                         }
+                                p >>= 1 ;       // next one
                                 }
-                        c >>= 1 ;       // next one
-                        py += my ;
                         }
+                return ;
+                }
+
+        /*
+         * screen byte of the first pixel line, shift and masks
+         */
+        scr = PAL_screen + ((unsigned int)y << 4) + (x >> 3) ;
+        sh = 1 << (x & 7) ;
+        m = 0x3f * sh ;
+        ml = ~(unsigned char)m ;
+        mh = ~(unsigned char)(m >> 8) ;
+
+        switch(size)
+                {
+                case PAL_CHAR_STANDARD:
+                        if(sh == 1)     // byte aligned
+                                {
+                                for(j = 0 ; j < 8 ; j++)
+                                        {
+                                        *scr = (*scr & 0xc0) | *ptr++ ;
+                                        scr += PAL_X / 8 ;
+                                        }
+                                }
+                        else
+                                {
+                                for(j = 0 ; j < 8 ; j++)
+                                        {
+                                        PAL_GLYPH_ROW(scr, *ptr++, sh, ml, mh) ;
+                                        scr += PAL_X / 8 ;
+                                        }
+                                }
+                        break ;
+
+                case PAL_CHAR_DHEIGHT:
+                        for(j = 0 ; j < 8 ; j++)
+                                {
+                                p = *ptr++ ;
+                                PAL_GLYPH_ROW(scr, p, sh, ml, mh) ;
+                                scr += PAL_X / 8 ;
+                                PAL_GLYPH_ROW(scr, p, sh, ml, mh) ;
+                                scr += PAL_X / 8 ;
+                                }
+                        break ;
+
+                default:
+                        /*
+                         * double width : left and right halves are two 6 pixels patterns
+                         */
+                        i = (x & 7) + 6 ;
+                        scr2 = scr + (i >> 3) ;
+                        sh2 = 1 << (i & 7) ;
+                        m = 0x3f * sh2 ;
+                        ml2 = ~(unsigned char)m ;
+                        mh2 = ~(unsigned char)(m >> 8) ;
+
+                        for(j = 0 ; j < 8 ; j++)
+                                {
+                                p = *ptr++ ;
+                                c = PAL_charDouble[p & 7] ;
+                                p = PAL_charDouble[p >> 3] ;
+                                for(sy = 0 ; sy < my ; sy++)    // once for DWIDTH, twice for DSIZE
+                                        {
+                                        PAL_GLYPH_ROW(scr, c, sh, ml, mh) ;
+                                        PAL_GLYPH_ROW(scr2, p, sh2, ml2, mh2) ;
+                                        scr += PAL_X / 8 ;
+                                        scr2 += PAL_X / 8 ;
+                                        }
+                                }
+                        break ;
                 }
         }
 
@@ -970,10 +1784,10 @@ void    PAL_write(unsigned char lig, unsigned char col, unsigned char *s, unsign
         lig <<= 3 ;     // a char is 8 pixels high
         col *= 6 ;      // and 6 pixel large
 
-        while(c = *s++) // parse all string
+        while((c = *s++)) // parse all string
                 {
                 PAL_char(col, lig, c, size) ; // print char
-                col += 6 *(size & 0x0f) ;              // next row
+                col += (unsigned char)(6 *(size & 0x0f)) ;              // next row
                 }
         }
 
@@ -997,10 +1811,10 @@ void    PAL_constWrite(unsigned char lig, unsigned char col, const unsigned char
 
         lig <<= 3 ;
         col *= 6 ;
-        while(c = *s++)
+        while((c = *s++))
                 {
                 PAL_char(col, lig, c, size) ;
-                col += 6 *(size & 0x0f) ;              // next row
+                col += (unsigned char)(6 *(size & 0x0f)) ;              // next row
                 }
         }
 
@@ -1015,36 +1829,25 @@ void    PAL_constWrite(unsigned char lig, unsigned char col, const unsigned char
  * requires :
  *      PAL_init must have been called
  * notes :
- *      data is arranged as a monochrome bitmap
- *      mikroElektronika GLCD bitmap editor tool does it very well :
- *              select T6963 and 128x128 for example.
+ *      x and sx are rounded down to a multiple of 8, no clipping.
+ *      data is arranged as the screen map : sx / 8 bytes per pixel line,
+ *      bit 0 is the leftmost pixel. tools/PAL_assets.cpp writes it from
+ *      a PBM file, bytes are copied as they are.
  */
 void    PAL_picture(unsigned char x, unsigned char y, const unsigned char *bm, unsigned char sx, unsigned char sy)
         {
-        unsigned char   i, j, k ;
-        unsigned char   px ;
-        unsigned int    py ;
-        unsigned char   c ;
+        unsigned char   i, j ;
+        unsigned char   *scr ;
 
         sx /= 8 ;
-        x /= 8 ;
+        scr = PAL_screen + (unsigned int)y * (PAL_X / 8) + x / 8 ;
         for(j = 0 ; j < sy ; j++)
                 {
-                py = (y + j) << 4 ;
                 for(i = 0 ; i < sx ; i++)
                         {
-                        unsigned char rc ;
-
-                        px = x + i ;
-                        c = *bm++ ;
-                        for(k = 0 ; k < 8 ; k++)
-                                {
-                                rc <<= 1 ;
-                                rc |= c & 1 ;
-                                c >>= 1 ;
-                                }
-
-                        PAL_screen[px + py] = rc ;
+                        scr[i] = *bm++ ;
                         }
+                scr += PAL_X / 8 ;
                 }
         }
+#endif
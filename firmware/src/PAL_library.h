@@ -1,5 +1,39 @@
 #define PAL_X      128
 
+/*
+ * vector area : rows below a given top are drawn from column spans,
+ * PAL_screen only holds the rows above it
+ * comment out PAL_VECTOR to draw all rows from PAL_screen
+ * PAL_SCREEN (the host bench defines it) draws all rows from PAL_screen,
+ * with no vector area, text area nor graticule
+ */
+#ifndef PAL_SCREEN
+#define PAL_VECTOR
+#endif
+#define PAL_VEC_ROWS            96      // max number of rows of the vector area
+
+/*
+ * text area : rows above the vector area are 8 x 8 pixels text cells,
+ * there is no PAL_screen, needs PAL_VECTOR
+ * comment out PAL_TEXT to draw them from PAL_screen
+ */
+#ifndef PAL_SCREEN
+#define PAL_TEXT
+#endif
+#define PAL_TEXT_ROWS           2       // max number of cell rows
+#define PAL_TEXT_COLS           16      // cells per row
+
+/*
+ * graticule : division grid and cursors ORed with the vector area by the ISR,
+ * needs PAL_VECTOR
+ * comment out PAL_GRAT for no graticule
+ */
+#ifndef PAL_SCREEN
+#define PAL_GRAT
+#endif
+#define PAL_GRAT_CURSORS        2       // number of horizontal cursors
+#define PAL_GRAT_OFF            0xff    // hidden cursor row
+
 #define PAL_CNTL_STOP           0
 #define PAL_CNTL_START          1
 
@@ -15,16 +49,47 @@
 #define PAL_CHAR_DHEIGHT        0x21
 #define PAL_CHAR_DSIZE          0x22
 
+#define PAL_CHAR_FIRST          32      // first char of PAL_charIndex
+#define PAL_CHAR_LAST           127     // last char of PAL_charIndex
+
+#ifndef PAL_TEXT
 extern  unsigned char   PAL_screen[] ;
+#endif
 extern  unsigned long   PAL_frameCtr ;
+extern  const unsigned char     PAL_charIndex[] ;
+extern  const unsigned char     PAL_charTable[] ;
+#ifdef PAL_VECTOR
+extern  unsigned char   PAL_vecLo[] ;
+extern  unsigned char   PAL_vecHi[] ;
+#endif
+#ifdef PAL_TEXT
+extern  unsigned char   PAL_text[] ;
+#endif
 
 void    PAL_ISR() ;
 void    PAL_init(unsigned char y) ;
 void    PAL_control(unsigned char st, unsigned char rd) ;
-void    PAL_fill(unsigned char c) ;
 void    PAL_setBorder(unsigned char border) ;
+void    PAL_vblankWait() ;
+void    PAL_setVblank(void (*hook)()) ;
+unsigned long   PAL_vblankCycles() ;
+#ifdef PAL_VECTOR
+void    PAL_vecInit(unsigned char top) ;
+void    PAL_vecCommit() ;
+#endif
+#ifdef PAL_GRAT
+void    PAL_gratInit(unsigned char center, unsigned char div) ;
+void    PAL_gratCursor(unsigned char n, unsigned char y) ;
+#endif
+#ifdef PAL_TEXT
+void    PAL_textWrite(unsigned char row, unsigned char col, char *s) ;
+#endif
+#ifndef PAL_TEXT
+void    PAL_fill(unsigned char c) ;
 void    PAL_setPixel(char x, char y, unsigned char mode) ;
 void    PAL_line(char x0, char y0, char x1, char y1, unsigned char pcolor) ;
+void    PAL_vline(char x, char y0, char y1, unsigned char pcolor) ;
+void    PAL_hline(char x0, char x1, char y, unsigned char pcolor) ;
 void    PAL_circle(char x, char y, char r, unsigned char pcolor) ;
 void    PAL_box(char x0, char y0, char x1, char y1, unsigned char pcolor) ;
 void    PAL_rectangle(char x0, char y0, char x1, char y1, unsigned char pcolor) ;
@@ -33,3 +98,4 @@ void    PAL_write(unsigned char lig, unsigned char col, unsigned char *s, unsign
 void    PAL_constWrite(unsigned char lig, unsigned char col, const unsigned char *s, unsigned char size) ;
 void    PAL_picture(unsigned char x, unsigned char y, const unsigned char *bm, unsigned char sx, unsigned char sy) ;
 //void    PAL_pictureAlign(unsigned char x, unsigned char y, const unsigned char *bm, unsigned char sx, unsigned char sy) ;
+#endif
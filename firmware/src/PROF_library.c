@@ -0,0 +1,272 @@
+/*
+ * file         : PROF_library.c
+ * project      : oscillo-pic18
+ * compiler     : mikroC
+ *
+ * description  :
+ *      cycle profiler for PIC18 MCU
+ *      TIMER 1 runs free at the instruction clock for the frequency counter,
+ *      its value is the cycle stamp of the profiler :
+ *      - PAL_ISR takes a 16 bits stamp on entry and on exit, and adds the
+ *        difference to PROF_isrSum
+ *      - main loop sections are enclosed in PROF_BEGIN / PROF_END, 32 bits
+ *        stamps extended by FREQ_ovf, cycles and calls are added to the slot
+ *      - PROF_EVENT counts events, A/D conversions or loop iterations
+ *      PROF_frame takes a snapshot of the counters once per frame, when
+ *      PAL_frameCtr has changed, and clears them.
+ *
+ *      TIMER 3 is not used : it is the sample clock of the acquisition and
+ *      CCP2 resets it every sample period.
+ *
+ *      stamps are wall clock time : a main loop section includes the
+ *      interrupts that preempted it. PAL_ISR time does not include the
+ *      interrupt context save and restore (about 40 cycles per line).
+ *
+ * cost :
+ *      PAL_ISR : about 30 cycles per line, sync edges and video move by
+ *      the entry stamp, the picture is shifted right by 1 or 2 pixels.
+ *      main loop : about 60 cycles per section, 250 cycles per snapshot,
+ *      PROF_format is about 3000 cycles.
+ *      build without PROF for release : all macros are empty.
+ */
+
+#include        "PROF_library.h"
+
+#ifdef PROF
+
+#include        "FREQ_library.h"
+#include        "PAL_library.h"
+
+/***************
+ * RAM variables
+ ***************/
+unsigned char   PROF_tmr1h ;                    // TMR1H buffer saved by PROF_STAMP
+INT_U16         PROF_isrStart ;                 // PAL_ISR entry stamp
+unsigned long   PROF_isrSum = 0 ;               // cycles in PAL_ISR
+unsigned int    PROF_isrMax = 0 ;               // longest PAL_ISR call
+unsigned int    PROF_events[PROF_EVENTS] ;      // events
+
+INT_U32         PROF_start[PROF_SLOTS] ;        // stamp of PROF_begin
+unsigned long   PROF_cycles[PROF_SLOTS] ;       // cycles in each section
+unsigned int    PROF_calls[PROF_SLOTS] ;        // calls of each section
+unsigned int    PROF_expected[PROF_EVENTS] ;    // expected events per frame, 0 for none
+
+unsigned char   PROF_frameLast ;                // PAL_frameCtr LSB of last snapshot
+
+PROF_SNAPSHOT   PROF_snap ;                     // last snapshot
+
+/*********************
+ * LIBRARY FUNCTIONS
+ *********************/
+
+/************************************
+ * PROF_stamp : 32 bits cycle stamp
+ * TIMER 1 and its overflow counter, read with low priority
+ * interrupts off. A pending overflow is counted if TIMER 1 has wrapped
+ * before the read.
+ ***********************************/
+static INT_U32  PROF_stamp()
+        {
+        INT_U16         lo, hi ;
+
+        INTCON.GIEL = 0 ;
+        lo = TMR1L ;
+        lo |= (INT_U16)(TMR1H << 8) ;
+        hi = FREQ_ovf ;
+        if(PIR1.TMR1IF && !(lo & 0x8000)) hi++ ;
+        INTCON.GIEL = 1 ;
+
+        return(((INT_U32)hi << 16) | lo) ;
+        }
+
+/**********************************************
+ * PROF_init : clear the counters
+ * parameters :
+ *      none
+ * returns :
+ *      nothing
+ * requires :
+ *      FREQ_init (TIMER 1 and FREQ_ovf)
+ *      PAL_init
+ * notes :
+ *      first snapshot is at the next frame
+ */
+void    PROF_init()
+        {
+        INTCON.GIEH = 0 ;
+        PROF_isrSum = 0 ;
+        PROF_isrMax = 0 ;
+        memset(PROF_events, 0, sizeof(PROF_events)) ;
+        INTCON.GIEH = 1 ;
+
+        memset(PROF_cycles, 0, sizeof(PROF_cycles)) ;
+        memset(PROF_calls, 0, sizeof(PROF_calls)) ;
+        memset(PROF_expected, 0, sizeof(PROF_expected)) ;
+        memset(&PROF_snap, 0, sizeof(PROF_snap)) ;
+        PROF_frameLast = (unsigned char)PAL_frameCtr ;
+        }
+
+/**********************************************
+ * PROF_expect : expected event count
+ * parameters :
+ *      e : event, PROF_SAMPLES or PROF_LOOPS
+ *      n : expected events per frame, 0 for none
+ * returns :
+ *      nothing
+ * requires :
+ *      PROF_init
+ * notes :
+ *      the snapshot gets the missing events in dropped[e],
+ *      for A/D conversions n is PROF_FRAME_CYCLES / sample period
+ */
+void    PROF_expect(unsigned char e, unsigned int n)
+        {
+        PROF_expected[e] = n ;
+        }
+
+/**********************************************
+ * PROF_begin : start of a main loop section
+ * parameters :
+ *      s : section, PROF_PAINT to PROF_IDLE
+ * returns :
+ *      nothing
+ * requires :
+ *      PROF_init
+ * notes :
+ *      use PROF_BEGIN, it is empty without PROF
+ */
+void    PROF_begin(unsigned char s)
+        {
+        PROF_start[s] = PROF_stamp() ;
+        }
+
+/**********************************************
+ * PROF_end : end of a main loop section
+ * parameters :
+ *      s : section, PROF_PAINT to PROF_IDLE
+ * returns :
+ *      nothing
+ * requires :
+ *      PROF_begin(s)
+ * notes :
+ *      use PROF_END, it is empty without PROF
+ */
+void    PROF_end(unsigned char s)
+        {
+        PROF_cycles[s] += PROF_stamp() - PROF_start[s] ;
+        PROF_calls[s]++ ;
+        }
+
+/**********************************************
+ * PROF_frame : per frame snapshot
+ * parameters :
+ *      none
+ * returns :
+ *      1 if PROF_snap is new, 0 otherwise
+ * requires :
+ *      PROF_init
+ * notes :
+ *      call it once per main loop, after PAL_vblankWait for one snapshot
+ *      per frame. Frames missed by the main loop are in PROF_snap.frames,
+ *      counters are totals over these frames.
+ *      use PROF_FRAME, it is 0 without PROF
+ */
+unsigned char   PROF_frame()
+        {
+        unsigned char   i, frames ;
+        unsigned long   n ;
+
+        frames = (unsigned char)PAL_frameCtr - PROF_frameLast ;        // one byte read is atomic
+        if(frames == 0) return(0) ;
+        PROF_frameLast += frames ;
+
+        PROF_snap.frames = frames ;
+
+        INTCON.GIEH = 0 ;
+        PROF_snap.isr = PROF_isrSum ;
+        PROF_snap.isrMax = PROF_isrMax ;
+        PROF_isrSum = 0 ;
+        PROF_isrMax = 0 ;
+        for(i = 0 ; i < PROF_EVENTS ; i++)
+                {
+                PROF_snap.events[i] = PROF_events[i] ;
+                PROF_events[i] = 0 ;
+                }
+        INTCON.GIEH = 1 ;
+
+        for(i = 0 ; i < PROF_SLOTS ; i++)
+                {
+                PROF_snap.cycles[i] = PROF_cycles[i] ;
+                PROF_snap.calls[i] = PROF_calls[i] ;
+                PROF_cycles[i] = 0 ;
+                PROF_calls[i] = 0 ;
+                }
+
+        for(i = 0 ; i < PROF_EVENTS ; i++)
+                {
+                n = (unsigned long)PROF_expected[i] * frames ;
+                PROF_snap.dropped[i] = (PROF_snap.events[i] < n) ? (unsigned int)(n - PROF_snap.events[i]) : 0 ;
+                }
+
+        return(1) ;
+        }
+
+/************************************
+ * PROF_percent : share of the snapshot frames, 0 to 99
+ ***********************************/
+static unsigned char    PROF_percent(unsigned long c)
+        {
+        unsigned long   percent ;
+
+        percent = (PROF_FRAME_CYCLES / 100) * PROF_snap.frames ;  // cycles per percent
+        c /= percent ;
+        if(c > 99) return(99) ;
+        return((unsigned char)c) ;
+        }
+
+/************************************
+ * PROF_digits : 1 or 2 digits, 99 at most
+ ***********************************/
+static char     *PROF_digits(char *p, unsigned int v)
+        {
+        if(v > 99) v = 99 ;
+        if(v >= 10) *p++ = (char)('0' + v / 10) ;
+        *p++ = (char)('0' + v % 10) ;
+        return(p) ;
+        }
+
+/**********************************************
+ * PROF_format : debug line of the last snapshot
+ * parameters :
+ *      dst : destination string, PROF_SIZE bytes
+ * returns :
+ *      nothing
+ * requires :
+ *      PROF_frame has returned 1
+ * notes :
+ *      16 chars for one text row : "I52 P31 W12 D0"
+ *      I : PAL_ISR, P : curve spans, W : waits, % of the frame time
+ *      D : A/D conversions dropped per frame
+ *      the glyphs I, P, W and D must be in PAL_assets.c
+ */
+void    PROF_format(char *dst)
+        {
+        char    *p ;
+
+        p = dst ;
+        *p++ = 'I' ;
+        p = PROF_digits(p, PROF_percent(PROF_snap.isr)) ;
+        *p++ = ' ' ;
+        *p++ = 'P' ;
+        p = PROF_digits(p, PROF_percent(PROF_snap.cycles[PROF_PAINT])) ;
+        *p++ = ' ' ;
+        *p++ = 'W' ;
+        p = PROF_digits(p, PROF_percent(PROF_snap.cycles[PROF_IDLE])) ;
+        *p++ = ' ' ;
+        *p++ = 'D' ;
+        p = PROF_digits(p, PROF_snap.dropped[PROF_SAMPLES] / PROF_snap.frames) ;
+        while(p < dst + PROF_SIZE - 1) *p++ = ' ' ;
+        *p = 0 ;
+        }
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * cycle profiler
+ * uncomment PROF to build it, PROF_* macros are empty otherwise
+ * uncomment PROF_LINE to show the profile on the last text row
+ */
+//#define PROF
+//#define PROF_LINE
+
+#ifndef PROF
+#undef PROF_LINE
+#endif
+
+#include        "INT_types.h"
+
+#define PROF_FRAME_CYCLES       320000L // instruction cycles per frame (40 ms)
+
+#define PROF_PAINT              0       // main loop sections : curve spans
+#define PROF_COMMIT             1       // PAL_vecCommit
+#define PROF_TEXT               2       // PAL_textWrite
+#define PROF_IDLE               3       // waits for a record or a frame
+#define PROF_SLOTS              4
+
+#define PROF_SAMPLES            0       // events : A/D conversions
+#define PROF_LOOPS              1       // main loop iterations
+#define PROF_EVENTS             2
+
+#define PROF_SIZE               17      // debug line buffer size
+
+/*
+ * one snapshot, totals over PROF_snap.frames frames
+ */
+typedef struct
+        {
+        unsigned char   frames ;                        // frames since last snapshot
+        unsigned long   isr ;                           // cycles in PAL_ISR
+        unsigned int    isrMax ;                        // longest PAL_ISR call (cycles)
+        unsigned long   cycles[PROF_SLOTS] ;            // cycles in each main loop section
+        unsigned int    calls[PROF_SLOTS] ;             // calls of each main loop section
+        unsigned int    events[PROF_EVENTS] ;           // events
+        unsigned int    dropped[PROF_EVENTS] ;          // expected events that did not happen
+        } PROF_SNAPSHOT ;
+
+#ifdef PROF
+/*
+ * 16 bits TIMER 1 stamp in PAL_ISR : reading TMR1L overwrites the TMR1H
+ * buffer, it is restored for the 16 bits read PAL_ISR may have interrupted
+ */
+#define PROF_STAMP(v)   {\
+                        PROF_tmr1h = TMR1H ;\
+                        v = TMR1L ;\
+                        v |= (INT_U16)(TMR1H << 8) ;\
+                        TMR1H = PROF_tmr1h ;\
+                        }
+
+#define PROF_ISR_BEGIN  PROF_STAMP(PROF_isrStart)
+#define PROF_ISR_END    {\
+                        INT_U16         t ;\
+                        PROF_STAMP(t) ;\
+                        t = (INT_U16)(t - PROF_isrStart) ;\
+                        PROF_isrSum += t ;\
+                        if(t > PROF_isrMax) PROF_isrMax = t ;\
+                        }
+
+#define PROF_BEGIN(s)   PROF_begin(s)
+#define PROF_END(s)     PROF_end(s)
+#define PROF_EVENT(e)   PROF_events[e]++
+#define PROF_FRAME()    PROF_frame()
+#else
+#define PROF_ISR_BEGIN
+#define PROF_ISR_END
+#define PROF_BEGIN(s)
+#define PROF_END(s)
+#define PROF_EVENT(e)
+#define PROF_FRAME()    0
+#endif
+
+#ifdef PROF
+extern  unsigned char   PROF_tmr1h ;
+extern  INT_U16         PROF_isrStart ;
+extern  unsigned long   PROF_isrSum ;
+extern  unsigned int    PROF_isrMax ;
+extern  unsigned int    PROF_events[] ;
+extern  PROF_SNAPSHOT   PROF_snap ;
+
+void    PROF_init() ;
+void    PROF_expect(unsigned char e, unsigned int n) ;
+void    PROF_begin(unsigned char s) ;
+void    PROF_end(unsigned char s) ;
+unsigned char   PROF_frame() ;
+void    PROF_format(char *dst) ;
+#endif
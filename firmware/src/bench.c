@@ -0,0 +1,210 @@
+/*
+ * cycle benchmark image
+ * build it instead of main.c, with PAL_library.c and PAL_assets.c only, and
+ * PAL_SCREEN in the project level defines (all rows in PAL_screen, the
+ * drawing primitives are built). Run it in a PIC18F4550 simulator, MPLAB SIM
+ * with UART1 output or gpsim with its usart module on RC6.
+ *
+ * each kernel is run between two TIMER 1 stamps, at the instruction clock,
+ * with interrupts off : the simulator gives exact instruction cycles.
+ * The cost of the stamps is measured on an empty call and removed.
+ * The table is in BENCH_cycles (RAM) and sent on the EUSART (RC6, 115200 bauds),
+ * one line per kernel : its name and its cycles per call.
+ * BENCH_done() is called when the table is complete, a breakpoint stops there.
+ *
+ * the image has not been run in a simulator yet, there is no measured table.
+ */
+
+/* Headers */
+#include "PAL_library.h"  //PAL Library header
+
+/* Definitions */
+#define PAL_Y               104                 // number of vertical pixels, as main.c
+#define CURVE_TOP_Y         ((PAL_Y >> 1) + 32) // as main.c
+#define CURVE_Y(s)          (CURVE_TOP_Y - ((s) >> 2)) // y of a sample (px), as main.c
+
+#define BENCH_CALLS         8                   // calls per kernel, the cycles are the average
+#define BENCH_NAME          16                  // kernel name size
+
+// kernels
+enum {
+    BENCH_EMPTY,
+    BENCH_PIXEL_WHITE, BENCH_PIXEL_BLACK, BENCH_PIXEL_REVERSE, BENCH_PIXEL_OUT,
+    BENCH_LINE_O1, BENCH_LINE_O2, BENCH_LINE_O3, BENCH_LINE_O4,
+    BENCH_LINE_O5, BENCH_LINE_O6, BENCH_LINE_O7, BENCH_LINE_O8,
+    BENCH_HLINE, BENCH_VLINE,
+    BENCH_CHAR_ALIGNED, BENCH_CHAR_STANDARD, BENCH_CHAR_DWIDTH, BENCH_CHAR_DHEIGHT,
+    BENCH_CHAR_DSIZE, BENCH_CHAR_TRIPLE,
+    BENCH_FILL,
+    BENCH_ADC_Y, BENCH_ADC_COLUMNS,
+    BENCH_KERNELS
+};
+
+/* ROM tables */
+const char BENCH_names[BENCH_KERNELS][BENCH_NAME] = {
+    "empty",
+    "setPixel white", "setPixel black", "setPixel rev", "setPixel out",
+    "line oct 1", "line oct 2", "line oct 3", "line oct 4",
+    "line oct 5", "line oct 6", "line oct 7", "line oct 8",
+    "hline 64", "vline 64",
+    "char aligned", "char standard", "char dwidth", "char dheight",
+    "char dsize", "char 3x3",
+    "fill",
+    "adc to y", "adc to y x128"
+};
+
+// line end points of each octant, from (64, 52), 40 px along the major axis
+const signed char BENCH_octants[8][2] = {
+    { 40, 15 }, { 15, 40 }, { -15, 40 }, { -40, 15 },
+    { -40, -15 }, { -15, -40 }, { 15, -40 }, { 40, -15 }
+};
+
+/* RAM Variables */
+unsigned char PAL_screen[PAL_X * PAL_Y / 8];    // all rows, PAL_SCREEN
+
+unsigned int BENCH_cycles[BENCH_KERNELS];       // instruction cycles per call
+unsigned char BENCH_samples[PAL_X];             // ADC -> y input
+unsigned char BENCH_y[PAL_X];                   // ADC -> y output
+
+/* Functions */
+// empty call, calibrates the stamps
+void empty() {
+}
+
+// ADC -> y of one sample : the 8 MSB of the left justified result, as ACQ_ISR, then CURVE_Y
+void adc_y() {
+    unsigned char s;
+
+    s = ADRESH;
+    BENCH_y[0] = CURVE_Y(s);
+}
+
+// ADC -> y of one record
+void adc_columns() {
+    unsigned char x;
+
+    for(x = 0; x < PAL_X; x++) {
+        BENCH_y[x] = CURVE_Y(BENCH_samples[x]);
+    }
+}
+
+// send one char on the EUSART
+void put(char c) {
+    while(!TXSTA.TRMT);
+    TXREG = c;
+}
+
+// send a ROM string left justified on n chars
+void put_text(const char *s, unsigned char n) {
+    while(*s && n) {
+        put(*s++);
+        n--;
+    }
+    while(n--) put(' ');
+}
+
+// send a number right justified on n chars
+void put_number(unsigned int v, unsigned char n) {
+    char s[6];
+    unsigned char i;
+
+    i = 0;
+    do {
+        s[i++] = (char)('0' + v % 10);
+        v /= 10;
+    } while(v);
+    while(n-- > i) put(' ');
+    while(i) put(s[--i]);
+}
+
+// send the table
+void report() {
+    unsigned char k;
+
+    put_text("kernel", BENCH_NAME);
+    put_text("  cycles", 8);
+    put('\r');
+    put('\n');
+    for(k = BENCH_PIXEL_WHITE; k < BENCH_KERNELS; k++) {
+        put_text(BENCH_names[k], BENCH_NAME);
+        put_number(BENCH_cycles[k], 8);
+        put('\r');
+        put('\n');
+    }
+}
+
+// the table is complete : simulator breakpoint
+void BENCH_done() {
+    while(1);
+}
+
+/*
+ * runs a kernel BENCH_CALLS times between two TIMER 1 stamps,
+ * TIMER 1 is written high byte first and read low byte first (RD16)
+ */
+#define BENCH_RUN(k, call)  {                   \
+    sum = 0;                                    \
+    for(n = 0; n < BENCH_CALLS; n++) {          \
+        TMR1H = 0;                              \
+        TMR1L = 0;                              \
+        call;                                   \
+        t = TMR1L;                              \
+        t |= (unsigned int)TMR1H << 8;          \
+        sum += t;                               \
+    }                                           \
+    BENCH_cycles[k] = (unsigned int)(sum / BENCH_CALLS) - BENCH_cycles[BENCH_EMPTY]; \
+}
+
+// entry point
+void main(void) {
+    unsigned long sum;
+    unsigned int t;
+    unsigned char n, k;
+
+    // no interrupt, TIMER 1 at the instruction clock
+    INTCON = 0;
+    T1CON = 0b10000001;
+    // EUSART : 115200 bauds, 8N1
+    TRISC.F6 = 0;
+    BAUDCON.BRG16 = 1;
+    SPBRGH = 0;
+    SPBRG = 68;
+    TXSTA = 0b00100100;
+    RCSTA = 0b10000000;
+
+    PAL_init(PAL_Y);
+    PAL_fill(0);
+    for(n = 0; n < PAL_X; n++) BENCH_samples[n] = n << 1;
+    ADRESH = 0x96;
+    ADRESL = 0x80;
+
+    // stamps only
+    BENCH_cycles[BENCH_EMPTY] = 0;
+    BENCH_RUN(BENCH_EMPTY, empty());
+
+    BENCH_RUN(BENCH_PIXEL_WHITE, PAL_setPixel(61, 40, PAL_COLOR_WHITE));
+    BENCH_RUN(BENCH_PIXEL_BLACK, PAL_setPixel(61, 40, PAL_COLOR_BLACK));
+    BENCH_RUN(BENCH_PIXEL_REVERSE, PAL_setPixel(61, 40, PAL_COLOR_REVERSE));
+    BENCH_RUN(BENCH_PIXEL_OUT, PAL_setPixel(PAL_X, 40, PAL_COLOR_WHITE));
+
+    for(k = 0; k < 8; k++) {
+        BENCH_RUN(BENCH_LINE_O1 + k, PAL_line(64, 52, (char)(64 + BENCH_octants[k][0]), (char)(52 + BENCH_octants[k][1]), PAL_COLOR_REVERSE));
+    }
+    BENCH_RUN(BENCH_HLINE, PAL_hline(30, 93, 52, PAL_COLOR_REVERSE));
+    BENCH_RUN(BENCH_VLINE, PAL_vline(64, 20, 83, PAL_COLOR_REVERSE));
+
+    BENCH_RUN(BENCH_CHAR_ALIGNED, PAL_char(64, 40, '5', PAL_CHAR_STANDARD));
+    BENCH_RUN(BENCH_CHAR_STANDARD, PAL_char(61, 40, '5', PAL_CHAR_STANDARD));
+    BENCH_RUN(BENCH_CHAR_DWIDTH, PAL_char(61, 40, '5', PAL_CHAR_DWIDTH));
+    BENCH_RUN(BENCH_CHAR_DHEIGHT, PAL_char(61, 40, '5', PAL_CHAR_DHEIGHT));
+    BENCH_RUN(BENCH_CHAR_DSIZE, PAL_char(61, 40, '5', PAL_CHAR_DSIZE));
+    BENCH_RUN(BENCH_CHAR_TRIPLE, PAL_char(61, 40, '5', 0x33));
+
+    BENCH_RUN(BENCH_FILL, PAL_fill(0));
+
+    BENCH_RUN(BENCH_ADC_Y, adc_y());
+    BENCH_RUN(BENCH_ADC_COLUMNS, adc_columns());
+
+    report();
+    BENCH_done();
+}
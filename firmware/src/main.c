@@ -1,29 +1,66 @@
 /* Headers */
-#include "PAL_Library.h"  //PAL Library header
+#include "PAL_library.h"  //PAL Library header
+#include "ACQ_library.h"  //acquisition library header
+#include "AD_library.h"   //A/D converter header
+#include "FREQ_library.h" //frequency counter header
+#include "MEAS_library.h" //measurements header
+#include "FMT_library.h"  //number formatting header
+#include "PROF_library.h" //cycle profiler header
+#include "EXP_library.h"  //sample export header
+#include "DEEP_library.h" //deep record header
+#include "INTERP_library.h" //interpolation header
 
 /* Definitions */
-#define PAL_Y               120                 // number of vertical pixels
+#define PAL_Y               104                 // number of vertical pixels
+#define TEXT_Y              16                  // rows of the readout cells on top of screen, the curve is below (px)
 #define CURVE_CENTER_Y      (PAL_Y >> 1)        // center of the curve (px)
+#define CURVE_TOP_Y         (CURVE_CENTER_Y + 32) // y of sample 0, the curve is 64 px high, below text rows
 #define CURVE_AMPLITUDE     ((PAL_Y >> 1) - 2)  // amplitude of the curve (px)
+#define CURVE_DIV           16                  // rows per vertical division (px)
+#define CURVE_Y(s)          (CURVE_TOP_Y - ((s) >> 2)) // y of a sample (px)
+
+#define TRIGGER_LEVEL       0x80                // trigger level (sample code)
+#define CURSOR_TRIGGER      0                   // graticule cursor of the trigger level
 
 #define DISPLAY_MODE_LINE   0                   // wave display mode : line
 #define DISPLAY_MODE_DOT    1                   // wave display mode : dot
 #define DISPLAY_MODE_FILLED 2                   // wave display mode : filled under
 
+#define COLUMN_RECORD       0                   // columns are the samples of the record
+#define COLUMN_DEEP         1                   // columns are samples of the deep record
+#define COLUMN_ENVELOPE     2                   // columns are envelopes of the deep record
+#define COLUMN_INTERP       3                   // columns are interpolated between the samples of a sparse record
+
+// buttons, high when pressed ; RB5 to RB7 stay digital whatever ADCON1, RB6 and RB7 are shared with ICSP
+#define BUTTON_ZOOM         PORTB.F5            // next zoom level on each press, 1:1 after the last one
+#define BUTTON_BACK         PORTB.F6            // pan to older samples while held
+#define BUTTON_FORWARD      PORTB.F7            // pan to newer samples while held
+#define PAN_STEP            ACQ_DIV             // columns panned per frame while a pan button is held
+
 /* RAM Variables */
-unsigned char PAL_screen[PAL_X * PAL_Y / 8];    // screen memory
-unsigned long frequency = 0L;                   // frequency (Hz) [0;2^32-1]
-unsigned int tension = 0;                       // tension, (mV) [0;65335]
+unsigned long frequency = 0L;                   // frequency (mHz) [0;2^32-1]
+unsigned int tension = 0;                       // tension, peak to peak (mV) [0;65335]
 
-char frequency_display[] = "1.5625e-1 Hz";      // output format : "FREQ : %d"
-char tension_display[] = "2.5 V";               // output form "TENS : %d"
+char frequency_display[FMT_SIZE] = "0.000 Hz";  // output format : "1.562 kHz"
+char tension_display[FMT_SIZE] = "0.00 V";      // output format : "23.3 V"
+#ifdef PROF_LINE
+char profile_display[PROF_SIZE];                // output format : "I52 P31 W12 D0"
+#endif
 
 unsigned char pixel_x = 0;                      // current sample x coord (px)
-unsigned char pixel_y = 0;                      // current sample y coord (px)
-unsigned char last_pixel_x = 0;                 // previous sample x coord (px)
-unsigned char last_pixel_y = 0;                 // previous sample y coord (px)
 
 unsigned char display_mode = 0;                 // current display mode
+unsigned char display_zoom = 0;                 // log2 of deep record samples per column [0;DEEP_ENV_SHIFT_MAX]
+unsigned char display_interp = INTERP_SINC;     // interpolation of sparse records
+unsigned int display_pan = 0;                   // screen position from the end of the deep record (samples)
+unsigned char button_zoom = 0;                  // zoom button level at the last frame
+
+unsigned char column_lo, column_hi;             // span of the next column (px), lo > hi for an empty one
+unsigned char column_source;                    // where the next column comes from
+unsigned char column_first;                     // first sample of the record
+unsigned char column_blank;                     // empty columns before the first envelope
+
+unsigned char readout_dirty = 1;                // readout strings have changed
 
 /* Functions */
 void interrupt(void) {
@@ -31,78 +68,253 @@ void interrupt(void) {
     PAL_ISR();
 }
 
+void interrupt_low(void) {
+    //Input edge captured on RC2, shared by ETS trigger and frequency counter
+    if(PIR1.CCP1IF) {
+        ACQ_edge();
+        FREQ_edge();
+        PIR1.CCP1IF = 0;
+    }
+    //A/D sequences, then A/D samples
+    AD_ISR();
+    ACQ_ISR();
+    //Frequency counter time base
+    FREQ_ISR();
+    //Send exported records
+    EXP_ISR();
+}
+
+// format a readout (mV or mHz), padded so that it overwrites the previous one
+// returns 1 if the string has changed
+unsigned char readout(char *display, unsigned long value, unsigned char digits, const char *unit) {
+    char s[FMT_SIZE];
+    unsigned char n;
+
+    n = FMT_eng(s, value, -3, digits, unit);
+    while(n < FMT_SIZE - 1) { s[n++] = ' '; }
+    s[n] = 0;
+    if(!memcmp(s, display, FMT_SIZE))
+        return 0;
+    memcpy(display, s, FMT_SIZE);
+    return 1;
+}
+
+// pick the source of the columns and the first column
+// a screen of samples of the deep record, the record itself when the deep record
+// is shorter, the envelopes of the deep record, or the columns interpolated
+// around the trigger point of a sparse record
+void column_begin(unsigned char first) {
+    unsigned int length;                        // samples in the deep record
+    unsigned int cover;                         // samples covered by the envelopes
+    unsigned char shift;                        // log2 of columns per sample
+
+    column_first = first;
+    column_blank = 0;
+    length = DEEP_length();
+    if(display_zoom) {
+        column_source = COLUMN_ENVELOPE;
+        cover = length >> display_zoom;         // columns first
+        if(cover < PAL_X) {
+            column_blank = (unsigned char)(PAL_X - cover);       // the whole record, right aligned
+            display_pan = 0;
+        }
+        else cover = PAL_X;
+        if(cover == 0) return;
+        cover <<= display_zoom;
+        if(display_pan > length - cover) display_pan = length - cover;
+        DEEP_envBegin(length - cover - display_pan, display_zoom);
+        return;
+    }
+    shift = ACQ_sparseShift;
+    if(shift) {
+        column_source = COLUMN_INTERP;
+        INTERP_begin(first, (unsigned char)(ACQ_pre - (ACQ_pre >> shift)), shift, display_interp);
+        return;
+    }
+    if(length < PAL_X) {
+        column_source = COLUMN_RECORD;
+        display_pan = 0;
+        return;
+    }
+    column_source = COLUMN_DEEP;
+    if(display_pan > length - PAL_X) display_pan = length - PAL_X;
+    DEEP_begin(length - PAL_X - display_pan);
+}
+
+// span of the next column (px)
+void column_next() {
+    unsigned char s;
+
+    switch(column_source) {
+        case COLUMN_ENVELOPE:
+            if(column_blank) {
+                column_blank--;
+                column_lo = 0xff;
+                column_hi = 0;
+                return;
+            }
+            DEEP_envNext();
+            column_lo = CURVE_Y(DEEP_envMax);
+            column_hi = CURVE_Y(DEEP_envMin);
+            return;
+
+        case COLUMN_DEEP:
+            s = DEEP_next();
+            break;
+
+        case COLUMN_INTERP:
+            s = INTERP_next();
+            break;
+
+        case COLUMN_RECORD:
+        default:
+            s = ACQ_SAMPLE(column_first, 0);
+            column_first++;
+            break;
+    }
+    column_lo = CURVE_Y(s);
+    column_hi = column_lo;
+}
+
+// zoom and pan buttons, once per frame
+// the zoom steps through the envelope levels, the pan moves PAN_STEP columns
+// of the current zoom, it is clamped to the deep record by column_begin
+void buttons() {
+    unsigned char pressed;
+    unsigned int step;                          // samples
+
+    pressed = BUTTON_ZOOM;
+    if(pressed && !button_zoom) {
+        display_zoom = (display_zoom < DEEP_ENV_SHIFT_MAX) ? (unsigned char)(display_zoom + 1) : 0;
+    }
+    button_zoom = pressed;
+    step = (unsigned int)PAN_STEP << display_zoom;
+    if(BUTTON_BACK) {
+        display_pan += step;
+    }
+    if(BUTTON_FORWARD) {
+        display_pan = (display_pan > step) ? display_pan - step : 0;
+    }
+}
+
 // redraw the screen
 void paint() {
-    // clear screen
-    PAL_fill(0);
-    // draw frequency & tension
-    PAL_write(0, 1, frequency_display, PAL_CHAR_STANDARD);
-    PAL_write(1, 1, tension_display, PAL_CHAR_STANDARD);
-    // start rendering
-    PAL_control(PAL_CNTL_START, PAL_CNTL_RENDER);
-    // start drawing curve
-    while(pixel_x < PAL_X)
+    unsigned char first;                        // first sample of the record
+    unsigned char prev_lo, prev_hi;             // span of the previous column (px)
+    unsigned char span_lo, span_hi;             // span of the current column (px)
+    unsigned char next_lo, next_hi;             // span of the next column (px)
+    unsigned char lo, hi, mid;                  // span drawn for the current column (px)
+
+    // wait for a complete record
+    PROF_BEGIN(PROF_IDLE);
+    while(!ACQ_ready());
+    PROF_END(PROF_IDLE);
+    first = ACQ_take();
+    // measure record (statistics are kept by ACQ_ISR)
+    MEAS_record();
+    tension = MEAS_vpp;
+    readout_dirty |= readout(tension_display, tension, 3, "V");
+    // export record on the EUSART, stamped with the frame counter (40 ms)
+    EXP_record(first, (unsigned int)PAL_frameCtr);
+    /* Curve
+     * The curve is not drawn in screen memory, each column
+     * is a vertical span rendered by PAL_ISR.
+     * Samples are 8 bits, trimming them to 64 px requires
+     * dividing by 2^2. Bitsift division is then faster,
+     * bc E(x/2^2) = x >> 2;
+     * The samples are decoded from the deep record, its last
+     * screen is the record (display_pan = 0). Zoomed out, the
+     * columns are envelopes of 2^display_zoom of its samples.
+     */
+    PROF_BEGIN(PROF_PAINT);
+    column_begin(first);
+    column_next();
+    prev_lo = column_lo;
+    prev_hi = column_hi;
+    next_lo = column_lo;
+    next_hi = column_hi;
+    for(pixel_x = 0; pixel_x < PAL_X; pixel_x++)
     {
-      /* Getting a sample
-       * Trimming the sample requires mult. by 128 / 1024,
-       * which is like dividing by 2^3. Bitsift division
-       * is then faster, bc E(x/2^3) = x >> 3;
-       */
-      pixel_y = 64 - (ADC_Read(0) >> 4);
-      // saving pixel coords
-      last_pixel_y = pixel_x == 0 ? pixel_y : last_pixel_y;
-      last_pixel_x = pixel_x == 0 ? pixel_x : last_pixel_x;
-      // setting the pixel
-      switch(display_mode)
+      span_lo = next_lo;
+      span_hi = next_hi;
+      if(pixel_x < PAL_X - 1) {
+          column_next();
+          next_lo = column_lo;
+          next_hi = column_hi;
+      }
+      // an empty neighbour is joined to nothing
+      if(prev_lo > prev_hi) {
+          prev_lo = span_lo;
+          prev_hi = span_hi;
+      }
+      lo = span_lo;
+      hi = span_hi;
+      if(lo <= hi) switch(display_mode)
       {
           // dot mode on
           case DISPLAY_MODE_DOT:
-               // draw the pixel
-               PAL_setPixel(pixel_x, pixel_y, PAL_COLOR_WHITE);
                break;
 
-          // filled mode on
+          // filled mode on : down to the center
           case DISPLAY_MODE_FILLED:
-               // draw the pixel
-               PAL_setPixel(pixel_x, pixel_y, PAL_COLOR_WHITE);
-               // if pixel is not at center
-               if(pixel_y == CURVE_CENTER_Y)
-                   break;
-               // fill along y axis
-               PAL_line(pixel_x,
-                   pixel_y - (pixel_y > CURVE_CENTER_Y ? 1 : -1),
-                   pixel_x,
-                   CURVE_CENTER_Y,
-                   PAL_COLOR_REVERSE);
+               if(CURVE_CENTER_Y < lo) lo = CURVE_CENTER_Y;
+               if(CURVE_CENTER_Y > hi) hi = CURVE_CENTER_Y;
                break;
 
-          // line mode on (default mode)
+          // line mode on (default mode) : half way to the neighbour columns
           case DISPLAY_MODE_LINE:
           default:
-               // draw a line btwn the 2 newest pixels
-               PAL_line(last_pixel_x,
-                   last_pixel_y,
-                   pixel_x,
-                   pixel_y,
-                   PAL_COLOR_WHITE);
+               mid = (unsigned char)((span_lo + prev_hi) >> 1);
+               if(mid < lo) lo = mid;
+               mid = (unsigned char)((span_hi + prev_lo) >> 1);
+               if(mid > hi) hi = mid;
+               mid = (unsigned char)((span_lo + next_hi) >> 1);
+               if(mid < lo) lo = mid;
+               mid = (unsigned char)((span_hi + next_lo) >> 1);
+               if(mid > hi) hi = mid;
                break;
-
       }
+      PAL_vecLo[pixel_x] = lo;
+      PAL_vecHi[pixel_x] = hi;
 
       // TODO : REMOVE
-      if (PORTC) { display_mode = 1 - display_mode; }
-      // wait for some time (depends on the frequency)
-      Delay_ms(10);
-      // drawing next pixel
-      last_pixel_x = pixel_x;
-      last_pixel_y = pixel_y;
-      ++pixel_x;
-      // start rendering
-      PAL_control(PAL_CNTL_START, PAL_CNTL_RENDER);
+      if (PORTC.F0) { display_mode = 1 - display_mode; }
+      // next column
+      prev_lo = span_lo;
+      prev_hi = span_hi;
+    }
+    PROF_END(PROF_PAINT);
+    // capture next record
+    ACQ_release();
+    // curve on screen from next field
+    PROF_BEGIN(PROF_COMMIT);
+    PAL_vecCommit();
+    PROF_END(PROF_COMMIT);
+    // one picture per frame, text cells are written in the vertical blank
+    PROF_BEGIN(PROF_IDLE);
+    PAL_vblankWait();
+    PROF_END(PROF_IDLE);
+#ifdef PROF_LINE
+    // profile of last frame on the tension row
+    if(PROF_FRAME()) {
+        PROF_format(profile_display);
+        readout_dirty = 1;
+    }
+#else
+    (void)PROF_FRAME();
+#endif
+    // write frequency & tension into text cells, only if they have changed
+    if(readout_dirty) {
+        PROF_BEGIN(PROF_TEXT);
+        PAL_textWrite(0, 1, frequency_display);
+#ifdef PROF_LINE
+        PAL_textWrite(1, 1, profile_display);
+#else
+        PAL_textWrite(1, 1, tension_display);
+#endif
+        PROF_END(PROF_TEXT);
+        readout_dirty = 0;
     }
-    // resetting pixel count
-    pixel_x = 0;
-    last_pixel_x = -1;
 }
 
 
@@ -110,6 +322,7 @@ void paint() {
 void main(void) {
     // I/O configuration
     TRISA = 0xFF;
+    TRISB = 0xFF;
     TRISC = 0xFF;
     TRISD = 0;
     TRISE = 0;
@@ -118,10 +331,46 @@ void main(void) {
     // ADC configuration (see VCFG1/2)
     ADCON1 = 0x01;
 
-    // init ADC
-    ADC_Init();
+    // init acquisition on AN0
+    ACQ_init(0);
+    // trigger on rising edge at mid-scale, trigger point at center of screen
+    ACQ_setTrigger(ACQ_TRIG_AUTO, ACQ_TRIG_RISING, TRIGGER_LEVEL, 4);
+    ACQ_setPretrigger(50);
+    // 10 ms/div, glitches stay visible
+    ACQ_setDecimation(ACQ_DECIM_PEAK);
+    // fast timebases in real time, interpolated, instead of ETS
+    ACQ_setSparse(1);
+    ACQ_setTimebase(ACQ_TB_10MS);
+    // measurements for the +/- 15 V input stage
+    MEAS_setRange(MEAS_RANGE_15V);
+    // init frequency counter on RC2
+    FREQ_init();
+    // export records on RC6
+    EXP_init(EXP_BAUD_115200);
     // init PAL library
     PAL_init(PAL_Y);
+    PAL_vecInit(TEXT_Y);
+    // graticule and trigger level are drawn by PAL_ISR
+    PAL_gratInit(CURVE_CENTER_Y, CURVE_DIV);
+    PAL_gratCursor(CURSOR_TRIGGER, CURVE_Y(TRIGGER_LEVEL));
+#ifdef PROF
+    // cycle profiler, one A/D conversion per sample period is expected
+    PROF_init();
+    PROF_expect(PROF_SAMPLES, PROF_FRAME_CYCLES / ACQ_period);
+#endif
+    // start sampling
+    ACQ_control(ACQ_CNTL_START);
+    // start video
+    PAL_control(PAL_CNTL_START, PAL_CNTL_RENDER);
     // paint picture
-    while(1) { paint(); }
+    while(1) {
+        PROF_EVENT(PROF_LOOPS);
+        // new frequency measure (once per gate)
+        if(FREQ_ready()) {
+            frequency = FREQ_read();
+            readout_dirty |= readout(frequency_display, frequency, 4, "Hz");
+        }
+        buttons();
+        paint();
+    }
 }
@@ -0,0 +1,119 @@
+/*
+ * file         : INTERP_table.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      host side generator of the INTERP library ROM table
+ *      writes a mikroC source with INTERP_sinc, the windowed sin(x)/x
+ *      (Lanczos) coefficients of each upsampling factor 2^shift, shift in
+ *      [1;INTERP_SHIFT_MAX], and of each phase p in [1;2^shift-1] :
+ *      INTERP_TAPS signed coefficients in 1/128, for the samples k - 3 to
+ *      k + 4 of a point p / 2^shift after sample k. Phase 0 is sample k
+ *      itself, it has no row.
+ *      the coefficients of each phase are rounded so that they add up to
+ *      128 exactly, a constant signal goes through unchanged, and stay
+ *      below 128 to fit in a signed char.
+ *
+ * build & usage :
+ *      g++ -O2 -o INTERP_table tools/INTERP_table.cpp
+ *      ./INTERP_table > firmware/src/INTERP_table.c
+ */
+
+#include        <cmath>
+#include        <cstdio>
+
+#define INTERP_TAPS             8       // must match INTERP_library.h
+#define INTERP_SHIFT_MAX        4
+#define INTERP_ONE              128     // coefficient of 1
+#define INTERP_COEF_MAX         127     // largest signed char
+
+/*
+ * sin(pi x) / (pi x)
+ */
+static double   sinc(double x)
+        {
+        if(fabs(x) < 1e-9) return(1.0) ;
+
+        return(sin(M_PI * x) / (M_PI * x)) ;
+        }
+
+/*
+ * Lanczos kernel, as wide as the taps
+ */
+static double   lanczos(double x)
+        {
+        const double    a = INTERP_TAPS / 2 ;
+
+        if(fabs(x) >= a) return(0.0) ;
+
+        return(sinc(x) * sinc(x / a)) ;
+        }
+
+int     main()
+        {
+        int     shift, p, t, n, sum, best ;
+        int     c[INTERP_TAPS] ;
+        double  x[INTERP_TAPS] ;
+
+        printf("/*\n") ;
+        printf(" * file         : INTERP_table.c\n") ;
+        printf(" * project      : oscillo-pic18\n") ;
+        printf(" * compiler     : mikroC\n") ;
+        printf(" *\n") ;
+        printf(" * description  :\n") ;
+        printf(" *      INTERP library ROM table, generated by tools/INTERP_table.cpp, do not edit\n") ;
+        printf(" *      Lanczos window, %d taps, upsampling by 2 to %d\n", INTERP_TAPS, 1 << INTERP_SHIFT_MAX) ;
+        printf(" */\n\n") ;
+        printf("#include        \"INTERP_library.h\"\n\n") ;
+        printf("/*****************\n * ROM tables\n *****************/\n") ;
+        printf("/*\n * coefficients in 1/128 of the samples k - 3 to k + 4, for each phase\n") ;
+        printf(" * but 0 of each shift : phase p of shift s is at ((1 << s) - s - 2 + p) * INTERP_TAPS\n */\n") ;
+        printf("const signed char       INTERP_sinc[((1 << (INTERP_SHIFT_MAX + 1)) - INTERP_SHIFT_MAX - 2) * INTERP_TAPS] =\n        {\n") ;
+
+        for(shift = 1 ; shift <= INTERP_SHIFT_MAX ; shift++)
+                {
+                n = 1 << shift ;
+                printf("        // x%d\n", n) ;
+                for(p = 1 ; p < n ; p++)
+                        {
+                        sum = 0 ;
+                        for(t = 0 ; t < INTERP_TAPS ; t++)
+                                {
+                                x[t] = lanczos(t - 3 - (double)p / n) * INTERP_ONE ;
+                                c[t] = (int)lround(x[t]) ;
+                                if(c[t] > INTERP_COEF_MAX) c[t] = INTERP_COEF_MAX ;
+                                sum += c[t] ;
+                                }
+
+                        /*
+                         * exact unit gain : the coefficients that were rounded
+                         * the most in the other way take the difference
+                         */
+                        while(sum != INTERP_ONE)
+                                {
+                                best = -1 ;
+                                for(t = 0 ; t < INTERP_TAPS ; t++)
+                                        {
+                                        if((sum < INTERP_ONE) && (c[t] < INTERP_COEF_MAX)
+                                                && ((best < 0) || (x[t] - c[t] > x[best] - c[best]))) best = t ;
+                                        if((sum > INTERP_ONE)
+                                                && ((best < 0) || (c[t] - x[t] > c[best] - x[best]))) best = t ;
+                                        }
+                                c[best] += (sum < INTERP_ONE) ? 1 : -1 ;
+                                sum += (sum < INTERP_ONE) ? 1 : -1 ;
+                                }
+
+                        printf("       ") ;
+                        for(t = 0 ; t < INTERP_TAPS ; t++)
+                                {
+                                printf(" %4d%s", c[t], ((shift < INTERP_SHIFT_MAX) || (p + 1 < n) || (t + 1 < INTERP_TAPS)) ? "," : "") ;
+                                }
+                        printf("      // %d/%d\n", p, n) ;
+                        }
+                }
+
+        printf("        } ;\n") ;
+
+        return(0) ;
+        }
@@ -0,0 +1,564 @@
+/*
+ * file         : PAL_assets.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      host side generator of the PAL library ROM assets
+ *      writes a mikroC source with :
+ *      - the glyphs of the chars the firmware uses, and only them, taken from
+ *        the 6x8 TERMINAL font and transposed to the screen map order :
+ *        8 bytes per glyph, one per pixel line from top to bottom,
+ *        bit 0 is the leftmost pixel
+ *      - PAL_charIndex, the glyph of each char from PAL_CHAR_FIRST to
+ *        PAL_CHAR_LAST, chars out of the set get glyph 0 (space)
+ *      - pictures from PBM files, bit reversed to the screen map order,
+ *        so that PAL_picture copies bytes as they are
+ *      the firmware does not rebuild anything at run time, and the ROM
+ *      only holds the glyphs that can be shown.
+ *
+ * build & usage :
+ *      g++ -O2 -o PAL_assets tools/PAL_assets.cpp
+ *      ./PAL_assets -c " .0123456789DGHIMPVWkmnpuz" > firmware/src/PAL_assets.c
+ *      ./PAL_assets -c "..." -p logo logo.pbm > firmware/src/PAL_assets.c
+ *
+ *      -c chars : glyph set, space is always included,
+ *                 default is all chars from PAL_CHAR_FIRST to PAL_CHAR_LAST
+ *      -p name file : PBM picture (P1 or P4), black PBM pixels are
+ *                 white on screen, width is padded to a multiple of 8
+ *
+ *      run it again each time the firmware writes a new char : chars out
+ *      of the set are shown as spaces.
+ */
+
+#include        <cstdio>
+#include        <cstdlib>
+#include        <cstring>
+#include        <string>
+#include        <vector>
+
+#define PAL_CHAR_FIRST          32      // must match PAL_library.h
+#define PAL_CHAR_LAST           127
+
+/*
+ * TERMINAL fonts
+ * 6x8 ASCII character table, starts from 0 (32 = space) up to 255
+ * 6 bytes per char, one per pixel column from left to right,
+ * bit 0 is the top pixel
+ */
+static const unsigned char      fontColumns[256 * 6] =
+        {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x3E, 0x5B, 0x4F, 0x5B, 0x3E, 0x00,
+        0x3E, 0x6B, 0x4F, 0x6B, 0x3E, 0x00,
+        0x1C, 0x3E, 0x7C, 0x3E, 0x1C, 0x00,
+        0x18, 0x3C, 0x7E, 0x3C, 0x18, 0x00,
+        0x1C, 0x57, 0x7D, 0x57, 0x1C, 0x00,
+        0x1C, 0x5E, 0x7F, 0x5E, 0x1C, 0x00,
+        0x00, 0x18, 0x3C, 0x18, 0x00, 0x00,
+        0xFF, 0xE7, 0xC3, 0xE7, 0xFF, 0x00,
+        0x00, 0x18, 0x24, 0x18, 0x00, 0x00,
+        0xFF, 0xE7, 0xDB, 0xE7, 0xFF, 0x00,
+        0x30, 0x48, 0x3A, 0x06, 0x0E, 0x00,
+        0x26, 0x29, 0x79, 0x29, 0x26, 0x00,
+        0x40, 0x7F, 0x05, 0x05, 0x07, 0x00,
+        0x40, 0x7F, 0x05, 0x25, 0x3F, 0x00,
+        0x5A, 0x3C, 0xE7, 0x3C, 0x5A, 0x00,
+        0x7F, 0x3E, 0x1C, 0x1C, 0x08, 0x00,
+        0x08, 0x1C, 0x1C, 0x3E, 0x7F, 0x00,
+        0x14, 0x22, 0x7F, 0x22, 0x14, 0x00,
+        0x5F, 0x5F, 0x00, 0x5F, 0x5F, 0x00,
+        0x06, 0x09, 0x7F, 0x01, 0x7F, 0x00,
+        0x00, 0x66, 0x89, 0x95, 0x6A, 0x00,
+        0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+        0x94, 0xA2, 0xFF, 0xA2, 0x94, 0x00,
+        0x08, 0x04, 0x7E, 0x04, 0x08, 0x00,
+        0x10, 0x20, 0x7E, 0x20, 0x10, 0x00,
+        0x08, 0x08, 0x2A, 0x1C, 0x08, 0x00,
+        0x08, 0x1C, 0x2A, 0x08, 0x08, 0x00,
+        0x1E, 0x10, 0x10, 0x10, 0x10, 0x00,
+        0x0C, 0x1E, 0x0C, 0x1E, 0x0C, 0x00,
+        0x30, 0x38, 0x3E, 0x38, 0x30, 0x00,
+        0x06, 0x0E, 0x3E, 0x0E, 0x06, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x5F, 0x00, 0x00, 0x00,
+        0x00, 0x07, 0x00, 0x07, 0x00, 0x00,
+        0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00,
+        0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00,
+        0x23, 0x13, 0x08, 0x64, 0x62, 0x00,
+        0x36, 0x49, 0x56, 0x20, 0x50, 0x00,
+        0x00, 0x08, 0x07, 0x03, 0x00, 0x00,
+        0x00, 0x1C, 0x22, 0x41, 0x00, 0x00,
+        0x00, 0x41, 0x22, 0x1C, 0x00, 0x00,
+        0x2A, 0x1C, 0x7F, 0x1C, 0x2A, 0x00,
+        0x08, 0x08, 0x3E, 0x08, 0x08, 0x00,
+        0x00, 0x80, 0x70, 0x30, 0x00, 0x00,
+        0x08, 0x08, 0x08, 0x08, 0x08, 0x00,
+        0x00, 0x00, 0x60, 0x60, 0x00, 0x00,
+        0x20, 0x10, 0x08, 0x04, 0x02, 0x00,
+        0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00,
+        0x00, 0x42, 0x7F, 0x40, 0x00, 0x00,
+        0x72, 0x49, 0x49, 0x49, 0x46, 0x00,
+        0x21, 0x41, 0x49, 0x4D, 0x33, 0x00,
+        0x18, 0x14, 0x12, 0x7F, 0x10, 0x00,
+        0x27, 0x45, 0x45, 0x45, 0x39, 0x00,
+        0x3C, 0x4A, 0x49, 0x49, 0x31, 0x00,
+        0x41, 0x21, 0x11, 0x09, 0x07, 0x00,
+        0x36, 0x49, 0x49, 0x49, 0x36, 0x00,
+        0x46, 0x49, 0x49, 0x29, 0x1E, 0x00,
+        0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+        0x00, 0x40, 0x34, 0x00, 0x00, 0x00,
+        0x00, 0x08, 0x14, 0x22, 0x41, 0x00,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x00,
+        0x00, 0x41, 0x22, 0x14, 0x08, 0x00,
+        0x02, 0x01, 0x59, 0x09, 0x06, 0x00,
+        0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x00,
+        0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00,
+        0x7F, 0x49, 0x49, 0x49, 0x36, 0x00,
+        0x3E, 0x41, 0x41, 0x41, 0x22, 0x00,
+        0x7F, 0x41, 0x41, 0x41, 0x3E, 0x00,
+        0x7F, 0x49, 0x49, 0x49, 0x41, 0x00,
+        0x7F, 0x09, 0x09, 0x09, 0x01, 0x00,
+        0x3E, 0x41, 0x41, 0x51, 0x73, 0x00,
+        0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00,
+        0x00, 0x41, 0x7F, 0x41, 0x00, 0x00,
+        0x20, 0x40, 0x41, 0x3F, 0x01, 0x00,
+        0x7F, 0x08, 0x14, 0x22, 0x41, 0x00,
+        0x7F, 0x40, 0x40, 0x40, 0x40, 0x00,
+        0x7F, 0x02, 0x1C, 0x02, 0x7F, 0x00,
+        0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00,
+        0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00,
+        0x7F, 0x09, 0x09, 0x09, 0x06, 0x00,
+        0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00,
+        0x7F, 0x09, 0x19, 0x29, 0x46, 0x00,
+        0x26, 0x49, 0x49, 0x49, 0x32, 0x00,
+        0x03, 0x01, 0x7F, 0x01, 0x03, 0x00,
+        0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00,
+        0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00,
+        0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00,
+        0x63, 0x14, 0x08, 0x14, 0x63, 0x00,
+        0x03, 0x04, 0x78, 0x04, 0x03, 0x00,
+        0x61, 0x59, 0x49, 0x4D, 0x43, 0x00,
+        0x00, 0x7F, 0x41, 0x41, 0x41, 0x00,
+        0x02, 0x04, 0x08, 0x10, 0x20, 0x00,
+        0x00, 0x41, 0x41, 0x41, 0x7F, 0x00,
+        0x04, 0x02, 0x01, 0x02, 0x04, 0x00,
+        0x40, 0x40, 0x40, 0x40, 0x40, 0x00,
+        0x00, 0x03, 0x07, 0x08, 0x00, 0x00,
+        0x20, 0x54, 0x54, 0x78, 0x40, 0x00,
+        0x7F, 0x28, 0x44, 0x44, 0x38, 0x00,
+        0x38, 0x44, 0x44, 0x44, 0x28, 0x00,
+        0x38, 0x44, 0x44, 0x28, 0x7F, 0x00,
+        0x38, 0x54, 0x54, 0x54, 0x18, 0x00,
+        0x00, 0x08, 0x7E, 0x09, 0x02, 0x00,
+        0x18, 0xA4, 0xA4, 0x9C, 0x78, 0x00,
+        0x7F, 0x08, 0x04, 0x04, 0x78, 0x00,
+        0x00, 0x44, 0x7D, 0x40, 0x00, 0x00,
+        0x20, 0x40, 0x40, 0x3D, 0x00, 0x00,
+        0x7F, 0x10, 0x28, 0x44, 0x00, 0x00,
+        0x00, 0x41, 0x7F, 0x40, 0x00, 0x00,
+        0x7C, 0x04, 0x78, 0x04, 0x78, 0x00,
+        0x7C, 0x08, 0x04, 0x04, 0x78, 0x00,
+        0x38, 0x44, 0x44, 0x44, 0x38, 0x00,
+        0xFC, 0x18, 0x24, 0x24, 0x18, 0x00,
+        0x18, 0x24, 0x24, 0x18, 0xFC, 0x00,
+        0x7C, 0x08, 0x04, 0x04, 0x08, 0x00,
+        0x48, 0x54, 0x54, 0x54, 0x24, 0x00,
+        0x04, 0x04, 0x3F, 0x44, 0x24, 0x00,
+        0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00,
+        0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00,
+        0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00,
+        0x44, 0x28, 0x10, 0x28, 0x44, 0x00,
+        0x4C, 0x90, 0x90, 0x90, 0x7C, 0x00,
+        0x44, 0x64, 0x54, 0x4C, 0x44, 0x00,
+        0x00, 0x08, 0x36, 0x41, 0x00, 0x00,
+        0x00, 0x00, 0x77, 0x00, 0x00, 0x00,
+        0x00, 0x41, 0x36, 0x08, 0x00, 0x00,
+        0x02, 0x01, 0x02, 0x04, 0x02, 0x00,
+        0x3C, 0x26, 0x23, 0x26, 0x3C, 0x00,
+        0x1E, 0xA1, 0xA1, 0x61, 0x12, 0x00,
+        0x3A, 0x40, 0x40, 0x20, 0x7A, 0x00,
+        0x38, 0x54, 0x54, 0x55, 0x59, 0x00,
+        0x21, 0x55, 0x55, 0x79, 0x41, 0x00,
+        0x21, 0x54, 0x54, 0x78, 0x41, 0x00,
+        0x21, 0x55, 0x54, 0x78, 0x40, 0x00,
+        0x20, 0x54, 0x55, 0x79, 0x40, 0x00,
+        0x0C, 0x1E, 0x52, 0x72, 0x12, 0x00,
+        0x39, 0x55, 0x55, 0x55, 0x59, 0x00,
+        0x39, 0x54, 0x54, 0x54, 0x59, 0x00,
+        0x39, 0x55, 0x54, 0x54, 0x58, 0x00,
+        0x00, 0x00, 0x45, 0x7C, 0x41, 0x00,
+        0x00, 0x02, 0x45, 0x7D, 0x42, 0x00,
+        0x00, 0x01, 0x45, 0x7C, 0x40, 0x00,
+        0xF0, 0x29, 0x24, 0x29, 0xF0, 0x00,
+        0xF0, 0x28, 0x25, 0x28, 0xF0, 0x00,
+        0x7C, 0x54, 0x55, 0x45, 0x00, 0x00,
+        0x20, 0x54, 0x54, 0x7C, 0x54, 0x44,
+        0x7C, 0x0A, 0x09, 0x7F, 0x49, 0x41,
+        0x32, 0x49, 0x49, 0x49, 0x32, 0x00,
+        0x32, 0x48, 0x48, 0x48, 0x32, 0x00,
+        0x32, 0x4A, 0x48, 0x48, 0x30, 0x00,
+        0x3A, 0x41, 0x41, 0x21, 0x7A, 0x00,
+        0x3A, 0x42, 0x40, 0x20, 0x78, 0x00,
+        0x00, 0x9D, 0xA0, 0xA0, 0x7D, 0x00,
+        0x39, 0x44, 0x44, 0x44, 0x39, 0x00,
+        0x3D, 0x40, 0x40, 0x40, 0x3D, 0x00,
+        0x3C, 0x24, 0xFF, 0x24, 0x24, 0x00,
+        0x48, 0x7E, 0x49, 0x43, 0x66, 0x00,
+        0x2B, 0x2F, 0xFC, 0x2F, 0x2B, 0x00,
+        0xFF, 0x09, 0x29, 0xF6, 0x20, 0x00,
+        0xC0, 0x88, 0x7E, 0x09, 0x03, 0x00,
+        0x20, 0x54, 0x54, 0x79, 0x41, 0x00,
+        0x00, 0x00, 0x44, 0x7D, 0x41, 0x00,
+        0x30, 0x48, 0x48, 0x4A, 0x32, 0x00,
+        0x38, 0x40, 0x40, 0x22, 0x7A, 0x00,
+        0x00, 0x7A, 0x0A, 0x0A, 0x72, 0x00,
+        0x7D, 0x0D, 0x19, 0x31, 0x7D, 0x00,
+        0x26, 0x29, 0x29, 0x2F, 0x28, 0x00,
+        0x26, 0x29, 0x29, 0x29, 0x26, 0x00,
+        0x30, 0x48, 0x4D, 0x40, 0x20, 0x00,
+        0x38, 0x08, 0x08, 0x08, 0x08, 0x00,
+        0x08, 0x08, 0x08, 0x08, 0x38, 0x00,
+        0x2F, 0x10, 0xC8, 0xAC, 0xBA, 0x00,
+        0x2F, 0x10, 0x28, 0x34, 0xFA, 0x00,
+        0x00, 0x00, 0x7B, 0x00, 0x00, 0x00,
+        0x08, 0x14, 0x2A, 0x14, 0x22, 0x00,
+        0x22, 0x14, 0x2A, 0x14, 0x08, 0x00,
+        0xAA, 0x00, 0x55, 0x00, 0xAA, 0x00,
+        0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55,
+        0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA,
+        0x00, 0x00, 0x00, 0xFF, 0x00, 0x00,
+        0x10, 0x10, 0x10, 0xFF, 0x00, 0x00,
+        0x14, 0x14, 0x14, 0xFF, 0x00, 0x00,
+        0x10, 0x10, 0xFF, 0x00, 0xFF, 0x00,
+        0x10, 0x10, 0xF0, 0x10, 0xF0, 0x00,
+        0x14, 0x14, 0x14, 0xFC, 0x00, 0x00,
+        0x14, 0x14, 0xF7, 0x00, 0xFF, 0x00,
+        0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+        0x14, 0x14, 0xF4, 0x04, 0xFC, 0x00,
+        0x14, 0x14, 0x17, 0x10, 0x1F, 0x00,
+        0x10, 0x10, 0x1F, 0x10, 0x1F, 0x00,
+        0x14, 0x14, 0x14, 0x1F, 0x00, 0x00,
+        0x10, 0x10, 0x10, 0xF0, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x1F, 0x10, 0x10,
+        0x10, 0x10, 0x10, 0x1F, 0x10, 0x10,
+        0x10, 0x10, 0x10, 0xF0, 0x10, 0x10,
+        0x00, 0x00, 0x00, 0xFF, 0x10, 0x10,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x10, 0xFF, 0x10, 0x10,
+        0x00, 0x00, 0x00, 0xFF, 0x14, 0x14,
+        0x00, 0x00, 0xFF, 0x00, 0xFF, 0x10,
+        0x00, 0x00, 0x1F, 0x10, 0x17, 0x14,
+        0x00, 0x00, 0xFC, 0x04, 0xF4, 0x14,
+        0x14, 0x14, 0x17, 0x10, 0x17, 0x14,
+        0x14, 0x14, 0xF4, 0x04, 0xF4, 0x14,
+        0x00, 0x00, 0xFF, 0x00, 0xF7, 0x14,
+        0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+        0x14, 0x14, 0xF7, 0x00, 0xF7, 0x14,
+        0x14, 0x14, 0x14, 0x17, 0x14, 0x14,
+        0x10, 0x10, 0x1F, 0x10, 0x1F, 0x10,
+        0x14, 0x14, 0x14, 0xF4, 0x14, 0x14,
+        0x10, 0x10, 0xF0, 0x10, 0xF0, 0x10,
+        0x00, 0x00, 0x1F, 0x10, 0x1F, 0x10,
+        0x00, 0x00, 0x00, 0x1F, 0x14, 0x14,
+        0x00, 0x00, 0x00, 0xFC, 0x14, 0x14,
+        0x00, 0x00, 0xF0, 0x10, 0xF0, 0x10,
+        0x10, 0x10, 0xFF, 0x10, 0xFF, 0x10,
+        0x14, 0x14, 0x14, 0xFF, 0x14, 0x14,
+        0x10, 0x10, 0x10, 0x1F, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xF0, 0x10, 0x10,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+        0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+        0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F,
+        0x38, 0x44, 0x44, 0x38, 0x44, 0x00,
+        0x7C, 0x2A, 0x2A, 0x3E, 0x14, 0x00,
+        0x7E, 0x02, 0x02, 0x06, 0x06, 0x00,
+        0x02, 0x7E, 0x02, 0x7E, 0x02, 0x00,
+        0x63, 0x55, 0x49, 0x41, 0x63, 0x00,
+        0x38, 0x44, 0x44, 0x3C, 0x04, 0x00,
+        0x40, 0x7E, 0x20, 0x1E, 0x20, 0x00,
+        0x06, 0x02, 0x7E, 0x02, 0x02, 0x00,
+        0x99, 0xA5, 0xE7, 0xA5, 0x99, 0x00,
+        0x1C, 0x2A, 0x49, 0x2A, 0x1C, 0x00,
+        0x4C, 0x72, 0x01, 0x72, 0x4C, 0x00,
+        0x30, 0x4A, 0x4D, 0x4D, 0x30, 0x00,
+        0x30, 0x48, 0x78, 0x48, 0x30, 0x00,
+        0xBC, 0x62, 0x5A, 0x46, 0x3D, 0x00,
+        0x3E, 0x49, 0x49, 0x49, 0x00, 0x00,
+        0x7E, 0x01, 0x01, 0x01, 0x7E, 0x00,
+        0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x00,
+        0x44, 0x44, 0x5F, 0x44, 0x44, 0x00,
+        0x40, 0x51, 0x4A, 0x44, 0x40, 0x00,
+        0x40, 0x44, 0x4A, 0x51, 0x40, 0x00,
+        0x00, 0x00, 0xFF, 0x01, 0x03, 0x00,
+        0xE0, 0x80, 0xFF, 0x00, 0x00, 0x00,
+        0x08, 0x08, 0x6B, 0x6B, 0x08, 0x08,
+        0x36, 0x12, 0x36, 0x24, 0x36, 0x00,
+        0x06, 0x0F, 0x09, 0x0F, 0x06, 0x00,
+        0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
+        0x00, 0x00, 0x10, 0x10, 0x00, 0x00,
+        0x30, 0x40, 0xFF, 0x01, 0x01, 0x00,
+        0x00, 0x1F, 0x01, 0x01, 0x1E, 0x00,
+        0x00, 0x19, 0x1D, 0x17, 0x12, 0x00,
+        0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        } ;
+
+/*
+ * picture to write
+ */
+struct picture
+        {
+        std::string             name ;
+        std::string             file ;
+        int                     width ;         // padded to a multiple of 8
+        int                     height ;
+        std::vector<unsigned char>      bytes ;         // screen map order
+        } ;
+
+/************************************
+ * glyphRows : transpose a TERMINAL glyph
+ * rows[8] gets one byte per pixel line, bit 0 is the leftmost pixel
+ ***********************************/
+static void     glyphRows(unsigned char c, unsigned char *rows)
+        {
+        int     x, y ;
+
+        for(y = 0 ; y < 8 ; y++)
+                {
+                rows[y] = 0 ;
+                for(x = 0 ; x < 6 ; x++)
+                        {
+                        if(fontColumns[c * 6 + x] & (1 << y)) rows[y] |= 1 << x ;
+                        }
+                }
+        }
+
+/************************************
+ * pbmToken : next header token of a PBM file, skips comments
+ ***********************************/
+static bool     pbmToken(FILE *f, std::string &tok)
+        {
+        int     c ;
+
+        tok.clear() ;
+        for(;;)
+                {
+                c = fgetc(f) ;
+                if(c == EOF) return(!tok.empty()) ;
+                if(c == '#')
+                        {
+                        while((c != '\n') && (c != EOF)) c = fgetc(f) ;
+                        if(!tok.empty()) return(true) ;
+                        continue ;
+                        }
+                if((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'))
+                        {
+                        if(!tok.empty()) return(true) ;
+                        continue ;
+                        }
+                tok += (char)c ;
+                }
+        }
+
+/************************************
+ * pbmRead : load a PBM picture in screen map order
+ * returns false and prints the reason on error
+ ***********************************/
+static bool     pbmRead(picture &p)
+        {
+        FILE            *f ;
+        std::string     magic, tok ;
+        int             x, y, c = 0, stride ;
+        unsigned char   ink ;
+
+        f = fopen(p.file.c_str(), "rb") ;
+        if(f == NULL)
+                {
+                fprintf(stderr, "PAL_assets: cannot open %s\n", p.file.c_str()) ;
+                return(false) ;
+                }
+
+        p.width = p.height = 0 ;
+        if(pbmToken(f, magic) && pbmToken(f, tok))
+                {
+                p.width = atoi(tok.c_str()) ;
+                if(pbmToken(f, tok)) p.height = atoi(tok.c_str()) ;
+                }
+        if(((magic != "P1") && (magic != "P4")) || (p.width <= 0) || (p.height <= 0)
+                || (p.width > 256) || (p.height > 255))
+                {
+                fprintf(stderr, "PAL_assets: %s is not a PBM picture of at most 256 x 255 pixels\n", p.file.c_str()) ;
+                fclose(f) ;
+                return(false) ;
+                }
+
+        stride = (p.width + 7) / 8 ;
+        p.bytes.assign(stride * p.height, 0) ;
+
+        for(y = 0 ; y < p.height ; y++)
+                {
+                for(x = 0 ; x < p.width ; x++)
+                        {
+                        if(magic == "P4")
+                                {
+                                /*
+                                 * raw rows are padded to a byte, MSB is the leftmost pixel
+                                 */
+                                if((x & 7) == 0) c = fgetc(f) ;
+                                if(c == EOF) break ;
+                                ink = (c >> (7 - (x & 7))) & 1 ;
+                                }
+                        else
+                                {
+                                do c = fgetc(f) ; while((c != '0') && (c != '1') && (c != EOF)) ;
+                                if(c == EOF) break ;
+                                ink = c - '0' ;
+                                }
+                        if(ink) p.bytes[y * stride + x / 8] |= 1 << (x & 7) ;
+                        }
+                if(x < p.width)
+                        {
+                        fprintf(stderr, "PAL_assets: %s is truncated\n", p.file.c_str()) ;
+                        fclose(f) ;
+                        return(false) ;
+                        }
+                }
+
+        fclose(f) ;
+        p.width = stride * 8 ;
+        return(true) ;
+        }
+
+/************************************
+ * printBytes : table body, 8 bytes per line
+ * more : the table goes on after these bytes
+ * comment : comment of the first line, or NULL
+ ***********************************/
+static void     printBytes(const unsigned char *b, size_t n, bool more, const char *comment)
+        {
+        size_t  i ;
+
+        for(i = 0 ; i < n ; i++)
+                {
+                printf("%s0x%02X%s", (i % 8) ? " " : "        ", b[i], ((i + 1 < n) || more) ? "," : "") ;
+                if((i % 8 == 7) || (i + 1 == n))
+                        {
+                        if(comment && (i < 8)) printf("%s      // %s", ((i + 1 < n) || more) ? "" : " ", comment) ;
+                        printf("\n") ;
+                        }
+                }
+        }
+
+int     main(int argc, char **argv)
+        {
+        std::string             set, command ;
+        std::vector<picture>    pictures ;
+        unsigned char           index[PAL_CHAR_LAST - PAL_CHAR_FIRST + 1] ;
+        unsigned char           rows[8] ;
+        std::vector<unsigned char>      glyphs ;
+        bool                    all = true ;
+        int                     i, c ;
+
+        command = "PAL_assets" ;
+        for(i = 1 ; i < argc ; i++)
+                {
+                if((strcmp(argv[i], "-c") == 0) && (i + 1 < argc))
+                        {
+                        set = argv[++i] ;
+                        all = false ;
+                        command += std::string(" -c \"") + set + "\"" ;
+                        }
+                else if((strcmp(argv[i], "-p") == 0) && (i + 2 < argc))
+                        {
+                        picture p ;
+
+                        p.name = argv[++i] ;
+                        p.file = argv[++i] ;
+                        if(!pbmRead(p)) return(1) ;
+                        pictures.push_back(p) ;
+                        command += " -p " + p.name + " " + p.file ;
+                        }
+                else
+                        {
+                        fprintf(stderr, "usage: PAL_assets [-c chars] [-p name file.pbm]...\n") ;
+                        return(1) ;
+                        }
+                }
+
+        /*
+         * glyph set, space first so that unknown chars and cleared cells are blank
+         */
+        if(all)
+                {
+                for(c = PAL_CHAR_FIRST + 1 ; c <= PAL_CHAR_LAST ; c++) set += (char)c ;
+                }
+        memset(index, 0, sizeof(index)) ;
+        glyphRows(' ', rows) ;
+        glyphs.insert(glyphs.end(), rows, rows + 8) ;
+        std::string     order = " " ;
+        for(i = 0 ; i < (int)set.size() ; i++)
+                {
+                c = (unsigned char)set[i] ;
+                if((c < PAL_CHAR_FIRST) || (c > PAL_CHAR_LAST))
+                        {
+                        fprintf(stderr, "PAL_assets: char 0x%02X is out of [%d;%d]\n", c, PAL_CHAR_FIRST, PAL_CHAR_LAST) ;
+                        return(1) ;
+                        }
+                if((c == ' ') || index[c - PAL_CHAR_FIRST]) continue ;
+                index[c - PAL_CHAR_FIRST] = glyphs.size() / 8 ;
+                glyphRows(c, rows) ;
+                glyphs.insert(glyphs.end(), rows, rows + 8) ;
+                order += (char)c ;
+                }
+
+        /*
+         * mikroC source
+         */
+        printf("/*\n") ;
+        printf(" * file         : PAL_assets.c\n") ;
+        printf(" * project      : oscillo-pic18\n") ;
+        printf(" * compiler     : mikroC\n") ;
+        printf(" *\n") ;
+        printf(" * description  :\n") ;
+        printf(" *      PAL library ROM assets, generated by tools/PAL_assets.cpp, do not edit\n") ;
+        printf(" *      %s\n", command.c_str()) ;
+        printf(" *      %d glyphs of the TERMINAL font, %d bytes\n", (int)glyphs.size() / 8, (int)(glyphs.size() + sizeof(index))) ;
+        printf(" */\n\n") ;
+        printf("#include        \"PAL_library.h\"\n\n") ;
+        printf("/*****************\n * ROM tables\n *****************/\n") ;
+        printf("/*\n * glyph of chars PAL_CHAR_FIRST to PAL_CHAR_LAST, 0 is space\n */\n") ;
+        printf("const unsigned char     PAL_charIndex[PAL_CHAR_LAST - PAL_CHAR_FIRST + 1] =\n        {\n") ;
+        for(i = 0 ; i < (int)sizeof(index) ; i++)
+                {
+                printf("%s%d%s", (i % 16) ? " " : "        ", index[i], (i + 1 < (int)sizeof(index)) ? "," : "") ;
+                if(i % 16 == 15) printf("\n") ;
+                }
+        printf("        } ;\n\n") ;
+        printf("/*\n * glyphs : 8 bytes per glyph, one per pixel line from top to bottom,\n") ;
+        printf(" * bit 0 is the leftmost pixel as in the screen map\n */\n") ;
+        printf("const unsigned char     PAL_charTable[] =\n        {\n") ;
+        for(i = 0 ; i < (int)order.size() ; i++)
+                {
+                char    name[8] ;
+
+                snprintf(name, sizeof(name), "'%c'", order[i]) ;
+                printBytes(&glyphs[i * 8], 8, i + 1 < (int)order.size(), name) ;
+                }
+        printf("        } ;\n") ;
+
+        for(i = 0 ; i < (int)pictures.size() ; i++)
+                {
+                picture &p = pictures[i] ;
+
+                printf("\n/*\n * %s : %d x %d pixels, for PAL_picture\n", p.name.c_str(), p.width, p.height) ;
+                printf(" * bit 0 is the leftmost pixel as in the screen map\n */\n") ;
+                printf("const unsigned char     %s[] =\n        {\n", p.name.c_str()) ;
+                printBytes(&p.bytes[0], p.bytes.size(), false, NULL) ;
+                printf("        } ;\n") ;
+                }
+
+        return(0) ;
+        }
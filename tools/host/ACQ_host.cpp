@@ -0,0 +1,21 @@
+/*
+ * file         : ACQ_host.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      ACQ_library.c for the host build : polling ACQ_ready runs the
+ *      emulated chip up to its next hardware event
+ */
+
+#define ACQ_ready       ACQ_readyTarget
+#include        "ACQ_library.c"
+#undef  ACQ_ready
+
+unsigned char   ACQ_ready()
+        {
+        if(ACQ_readyTarget()) return(1) ;
+
+        HAL_idle() ;
+        return(0) ;
+        }
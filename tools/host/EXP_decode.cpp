@@ -0,0 +1,433 @@
+/*
+ * file         : EXP_decode.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler, Linux
+ *
+ * description  :
+ *      host decoder of the sample export frames, see EXP_library.h
+ *      reads the stream of the EUSART (a serial port, a pty, a file or
+ *      stdin), checks each frame (sync, length, CRC, sequence), decodes the
+ *      4 bits differences, or takes the raw samples, and writes the records :
+ *      - CSV, one line per sample :
+ *              seq,stamp,index,time_us,code,mV
+ *        time is from the trigger point, mV from the range calibration
+ *      - binary, the sample codes of each record, ACQ_DEPTH bytes per record
+ *      at the end, the counters are shown on stderr : frames, bytes, CRC
+ *      errors, bytes skipped to find a frame, frames lost on the link
+ *      (sequence gaps) and records dropped by the firmware (link too slow),
+ *      and the sustained throughput, in host time and in board time (the
+ *      frame stamps count 40 ms frames).
+ *
+ * build & usage :
+ *      g++ -O2 -Ifirmware/src -o EXP_decode tools/host/EXP_decode.cpp
+ *
+ *      ./EXP_decode [-d device [-b baud] | -p] [-c file.csv] [-r file.bin] [-n frames]
+ *
+ *      -d device : serial port, set to raw 8N1 at baud, default 115200
+ *      -p : open a pty and decode what is written to it, its name is shown
+ *           on stderr ; the decoder ends when the writer closes it
+ *      -c file : write the samples as CSV, - for stdout
+ *      -r file : write the samples as binary
+ *      -n frames : stop after that many good frames
+ *      without -d or -p, the stream is read from stdin
+ *
+ *      end to end test, without the board : the host build of the firmware
+ *      sends its EUSART bytes to the pty
+ *              ./EXP_decode -p -c samples.csv
+ *              ./PAL_bench -f 250 -x /dev/pts/N
+ */
+
+#include        "ACQ_library.h"
+#include        "EXP_library.h"
+
+#include        <cerrno>
+#include        <chrono>
+#include        <cstdio>
+#include        <cstdlib>
+#include        <cstring>
+#include        <vector>
+
+#include        <fcntl.h>
+#include        <termios.h>
+#include        <unistd.h>
+
+#define DECODE_FCY              8.0     // instruction cycles per us
+#define DECODE_STAMP_MS         40.0    // ms per stamp, one PAL frame
+
+typedef std::chrono::steady_clock       decode_clock ;
+
+/*
+ * counters of the stream
+ */
+typedef struct
+        {
+        unsigned long   frames ;        // good frames
+        unsigned long   samples ;       // decoded samples
+        unsigned long long      bytes ; // bytes read
+        unsigned long long      payload ;       // bytes of good frames
+        unsigned long   crcErrors ;     // frames with a wrong CRC
+        unsigned long   badFrames ;     // frames with a good CRC that do not decode
+        unsigned long   skipped ;       // bytes skipped to find a sync
+        unsigned long   lost ;          // sequence numbers missing
+        unsigned long   dropped ;       // records dropped by the firmware
+        unsigned int    firstStamp ;
+        unsigned long   stamps ;        // board time of the good frames (stamps)
+        } DECODE_STATS ;
+
+/***************
+ * RAM variables
+ ***************/
+static DECODE_STATS     decode_stats ;
+static int              decode_haveSeq = 0 ;
+static unsigned char    decode_seq ;                    // last good sequence number
+static unsigned int     decode_stamp ;                  // last good stamp
+static FILE             *decode_csv = 0 ;               // -c
+static FILE             *decode_bin = 0 ;               // -r
+
+/************************************
+ * decode_crc : CRC-16 CCITT, as EXP_crc
+ ***********************************/
+static unsigned int     decode_crc(const unsigned char *p, unsigned int n)
+        {
+        unsigned int    crc ;
+        unsigned char   x ;
+
+        crc = 0xffff ;
+        while(n--)
+                {
+                x = (crc >> 8) ^ *p++ ;
+                x ^= x >> 4 ;
+                crc = ((crc << 8) ^ ((unsigned int)x << 12) ^ ((unsigned int)x << 5) ^ x) & 0xffff ;
+                }
+
+        return(crc) ;
+        }
+
+/************************************
+ * decode_record : samples of a record payload
+ * returns 0 if the payload is not a record
+ ***********************************/
+static int      decode_record(const unsigned char *p, unsigned int len, unsigned char seq)
+        {
+        unsigned char   codes[256] ;
+        unsigned int    stamp, span, n, i, k, nibbles ;
+        unsigned long   column ;
+        unsigned char   pre, zero, flags, stride, pred ;
+        int             d ;
+
+        if(len < EXP_META) return(0) ;
+
+        stamp = p[EXP_META_STAMP] | (p[EXP_META_STAMP + 1] << 8) ;
+        column = p[EXP_META_COLUMN] | (p[EXP_META_COLUMN + 1] << 8) | ((unsigned long)p[EXP_META_COLUMN + 2] << 16) ;
+        pre = p[EXP_META_PRE] ;
+        span = p[EXP_META_SPAN] | (p[EXP_META_SPAN + 1] << 8) ;
+        zero = p[EXP_META_ZERO] ;
+        n = p[EXP_META_SAMPLES] ;
+        flags = p[EXP_META_FLAGS] ;
+        stride = ((flags & ~EXP_FLAG_RAW) == (ACQ_DECIM_PEAK << 1)) ? 2 : 1 ;  // min/max pairs, not ETS
+
+        if(flags & EXP_FLAG_RAW)
+                {
+                /*
+                 * raw samples, one byte each
+                 */
+                if(len != EXP_META + n) return(0) ;
+                memcpy(codes, p + EXP_META, n) ;
+                }
+        else
+                {
+                /*
+                 * nibbles, high one first
+                 */
+                nibbles = (len - EXP_META) * 2 ;
+                k = 0 ;
+#define DECODE_NIBBLE(j)        ((p[EXP_META + ((j) >> 1)] >> (((j) & 1) ? 0 : 4)) & 0x0f)
+                for(i = 0 ; i < n ; i++)
+                        {
+                        if(k >= nibbles) return(0) ;
+                        d = DECODE_NIBBLE(k) ;
+                        k++ ;
+                        if(d == EXP_ESCAPE)
+                                {
+                                if(k + 2 > nibbles) return(0) ;
+                                codes[i] = (DECODE_NIBBLE(k) << 4) | DECODE_NIBBLE(k + 1) ;
+                                k += 2 ;
+                                }
+                        else if(i < stride)
+                                {
+                                return(0) ;                     // first samples are escaped
+                                }
+                        else
+                                {
+                                pred = codes[i - stride] ;
+                                if(i >= stride * 2u) pred += pred - codes[i - stride * 2] ;
+                                codes[i] = pred + ((d & 0x08) ? d - 16 : d) ;
+                                }
+                        }
+                if((k + 1) / 2 != len - EXP_META) return(0) ;   // trailing bytes
+#undef  DECODE_NIBBLE
+                }
+
+        /*
+         * the frame is good
+         */
+        if(decode_haveSeq)
+                {
+                decode_stats.lost += (unsigned char)(seq - decode_seq - 1) ;
+                decode_stats.stamps += (unsigned int)(stamp - decode_stamp) & 0xffff ;
+                }
+        else
+                {
+                decode_stats.firstStamp = stamp ;
+                }
+        decode_haveSeq = 1 ;
+        decode_seq = seq ;
+        decode_stamp = stamp ;
+        decode_stats.dropped += p[EXP_META_DROPPED] ;
+        decode_stats.frames++ ;
+        decode_stats.samples += n ;
+
+        if(decode_csv)
+                {
+                for(i = 0 ; i < n ; i++)
+                        {
+                        fprintf(decode_csv, "%u,%u,%u,%.3f,%u,%ld\n", seq, stamp, i,
+                                ((double)i - pre) * column / DECODE_FCY, codes[i],
+                                ((long)codes[i] - zero) * (long)span / 256) ;
+                        }
+                }
+        if(decode_bin) fwrite(codes, 1, n, decode_bin) ;
+
+        return(1) ;
+        }
+
+/************************************
+ * decode_parse : frames of the stream buffer
+ * returns the bytes used, the rest waits for more
+ ***********************************/
+static unsigned int     decode_parse(const unsigned char *b, unsigned int n)
+        {
+        unsigned int    i, len, crc ;
+
+        i = 0 ;
+        while(i < n)
+                {
+                if(b[i] != EXP_SYNC)
+                        {
+                        decode_stats.skipped++ ;
+                        i++ ;
+                        continue ;
+                        }
+                if(n - i < EXP_HEADER) break ;
+                len = b[i + 3] ;
+                if((b[i + 1] != EXP_TYPE_RECORD) || (len > EXP_PAYLOAD_MAX))
+                        {
+                        decode_stats.skipped++ ;                // not a frame header
+                        i++ ;
+                        continue ;
+                        }
+                if(n - i < EXP_HEADER + len + EXP_CRC) break ;
+
+                crc = (b[i + EXP_HEADER + len] << 8) | b[i + EXP_HEADER + len + 1] ;
+                if(decode_crc(b + i + 1, EXP_HEADER - 1 + len) != crc)
+                        {
+                        decode_stats.crcErrors++ ;
+                        decode_stats.skipped++ ;                // look for the next sync
+                        i++ ;
+                        continue ;
+                        }
+                if(decode_record(b + i + EXP_HEADER, len, b[i + 2])) decode_stats.payload += EXP_HEADER + len + EXP_CRC ;
+                else decode_stats.badFrames++ ;
+                i += EXP_HEADER + len + EXP_CRC ;
+                }
+
+        return(i) ;
+        }
+
+/************************************
+ * decode_serial : open a serial port, raw 8N1
+ ***********************************/
+static int      decode_serial(const char *device, long baud)
+        {
+        struct termios  t ;
+        speed_t         s ;
+        int             fd ;
+
+        switch(baud)
+                {
+                case 9600:      s = B9600 ; break ;
+                case 57600:     s = B57600 ; break ;
+                case 115200:    s = B115200 ; break ;
+                case 230400:    s = B230400 ; break ;
+                case 500000:    s = B500000 ; break ;
+                case 1000000:   s = B1000000 ; break ;
+                default:
+                        fprintf(stderr, "EXP_decode: unsupported baud rate %ld\n", baud) ;
+                        return(-1) ;
+                }
+
+        fd = open(device, O_RDONLY | O_NOCTTY) ;
+        if(fd < 0) return(-1) ;
+        if(tcgetattr(fd, &t) == 0)
+                {
+                cfmakeraw(&t) ;
+                cfsetispeed(&t, s) ;
+                cfsetospeed(&t, s) ;
+                t.c_cflag |= CLOCAL | CREAD ;
+                t.c_cc[VMIN] = 1 ;
+                t.c_cc[VTIME] = 0 ;
+                tcsetattr(fd, TCSANOW, &t) ;
+                }
+        return(fd) ;
+        }
+
+/************************************
+ * decode_pty : open a pty in raw mode, show the name of its slave side
+ ***********************************/
+static int      decode_pty()
+        {
+        struct termios  t ;
+        int             fd, slave ;
+        const char      *name ;
+
+        fd = posix_openpt(O_RDWR | O_NOCTTY) ;
+        if((fd < 0) || grantpt(fd) || unlockpt(fd) || !(name = ptsname(fd))) return(-1) ;
+
+        /*
+         * raw slave : no line discipline between the writer and the decoder
+         */
+        slave = open(name, O_RDWR | O_NOCTTY) ;
+        if((slave < 0) || tcgetattr(slave, &t)) return(-1) ;
+        cfmakeraw(&t) ;
+        tcsetattr(slave, TCSANOW, &t) ;
+        close(slave) ;
+
+        fprintf(stderr, "EXP_decode: write to %s\n", name) ;
+        return(fd) ;
+        }
+
+/************************************
+ * decode_report : counters and throughput
+ ***********************************/
+static void     decode_report(double seconds)
+        {
+        const DECODE_STATS      *s = &decode_stats ;
+        double          board ;
+
+        fprintf(stderr, "frames       %lu good, %lu CRC errors, %lu bad, %lu bytes skipped\n",
+                s->frames, s->crcErrors, s->badFrames, s->skipped) ;
+        fprintf(stderr, "loss         %lu frames lost on the link, %lu records dropped by the firmware\n",
+                s->lost >= s->dropped ? s->lost - s->dropped : 0, s->dropped) ;
+        fprintf(stderr, "samples      %lu, %.2f bits per sample\n",
+                s->samples, s->samples ? s->payload * 8.0 / s->samples : 0) ;
+        if(seconds > 0)
+                {
+                fprintf(stderr, "host time    %.3f s, %.0f bytes/s, %.1f frames/s, %.0f samples/s\n",
+                        seconds, s->bytes / seconds, s->frames / seconds, s->samples / seconds) ;
+                }
+        board = s->stamps * DECODE_STAMP_MS / 1000 ;
+        if(board > 0)
+                {
+                fprintf(stderr, "board time   %.3f s, %.0f bytes/s, %.1f frames/s, %.0f samples/s\n",
+                        board, s->payload / board, (s->frames - 1) / board, s->samples / board) ;
+                }
+        }
+
+int     main(int argc, char **argv)
+        {
+        const char      *device = 0 ;
+        long            baud = 115200 ;
+        int             pty = 0 ;
+        unsigned long   maxFrames = 0 ;
+        std::vector<unsigned char>      buf ;
+        decode_clock::time_point        t0 ;
+        unsigned char   chunk[4096] ;
+        unsigned int    used ;
+        int             fd, i, got ;
+        ssize_t         r ;
+
+        for(i = 1 ; i < argc ; i++)
+                {
+                if((strcmp(argv[i], "-d") == 0) && (i + 1 < argc))
+                        {
+                        device = argv[++i] ;
+                        }
+                else if((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))
+                        {
+                        baud = atol(argv[++i]) ;
+                        }
+                else if(strcmp(argv[i], "-p") == 0)
+                        {
+                        pty = 1 ;
+                        }
+                else if((strcmp(argv[i], "-c") == 0) && (i + 1 < argc))
+                        {
+                        i++ ;
+                        decode_csv = strcmp(argv[i], "-") ? fopen(argv[i], "w") : stdout ;
+                        if(!decode_csv)
+                                {
+                                fprintf(stderr, "EXP_decode: can't write %s\n", argv[i]) ;
+                                return(1) ;
+                                }
+                        fprintf(decode_csv, "seq,stamp,index,time_us,code,mV\n") ;
+                        }
+                else if((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))
+                        {
+                        i++ ;
+                        decode_bin = fopen(argv[i], "wb") ;
+                        if(!decode_bin)
+                                {
+                                fprintf(stderr, "EXP_decode: can't write %s\n", argv[i]) ;
+                                return(1) ;
+                                }
+                        }
+                else if((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+                        {
+                        maxFrames = atol(argv[++i]) ;
+                        }
+                else
+                        {
+                        fprintf(stderr, "usage: EXP_decode [-d device [-b baud] | -p] [-c file.csv] [-r file.bin] [-n frames]\n") ;
+                        return(1) ;
+                        }
+                }
+
+        fd = pty ? decode_pty() : device ? decode_serial(device, baud) : 0 ;
+        if(fd < 0)
+                {
+                fprintf(stderr, "EXP_decode: can't open %s\n", pty ? "a pty" : device) ;
+                return(1) ;
+                }
+
+        /*
+         * the host time starts with the first byte
+         */
+        memset(&decode_stats, 0, sizeof(decode_stats)) ;
+        got = 0 ;
+        for(;;)
+                {
+                r = read(fd, chunk, sizeof(chunk)) ;
+                if((r < 0) && (errno == EINTR)) continue ;
+                if(pty && (r < 0) && (errno == EIO) && !got)
+                        {
+                        usleep(10000) ;                         // no writer yet
+                        continue ;
+                        }
+                if(r <= 0) break ;                              // end of file, or the pty writer is gone
+                if(!got) t0 = decode_clock::now() ;
+                got = 1 ;
+
+                decode_stats.bytes += r ;
+                buf.insert(buf.end(), chunk, chunk + r) ;
+                used = decode_parse(buf.data(), buf.size()) ;
+                buf.erase(buf.begin(), buf.begin() + used) ;
+                if(maxFrames && (decode_stats.frames >= maxFrames)) break ;
+                }
+
+        decode_report(got ? std::chrono::duration<double>(decode_clock::now() - t0).count() : 0) ;
+
+        if(decode_csv && (decode_csv != stdout)) fclose(decode_csv) ;
+        if(decode_bin) fclose(decode_bin) ;
+
+        return(0) ;
+        }
@@ -0,0 +1,862 @@
+/*
+ * file         : HAL.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      emulated PIC18F4550 peripherals for the host build, see HAL.h
+ *
+ *      the chip runs on HAL_cycles, the instruction cycle clock. Each SFR
+ *      access takes one cycle : the clock moves on, hardware events that
+ *      are due are applied (timer overflows and matches, end of A/D
+ *      conversions, input edges), then the pending interrupts are
+ *      dispatched, as between two instructions.
+ */
+
+#include        "HAL.h"
+
+#include        <math.h>
+#include        <chrono>
+
+/*
+ * timer state : the count is derived from the clock while the timer runs
+ */
+typedef struct
+        {
+        unsigned long long      zero ;          // cycle of count 0, while running
+        unsigned long           count ;         // count, while stopped
+        unsigned char           on ;
+        unsigned int            pre ;           // cycles per count
+        unsigned char           buf ;           // RD16 high byte buffer
+        } HAL_TIMER ;
+
+#define HAL_NEVER       0xffffffffffffffffULL
+
+/***************
+ * RAM variables
+ ***************/
+#define HAL_SFR_DEFINE(name)    HAL_sfr name(HAL_##name) ;
+HAL_SFR_LIST(HAL_SFR_DEFINE)
+
+HAL_SIGNAL      HAL_signal[HAL_CHANNELS] =
+        {
+        { HAL_WAVE_SINE, 50.0, 400.0, 512.0, 0.0 },     // AN0 : 50 Hz sine
+        { HAL_WAVE_DC, 0.0, 0.0, 512.0, 0.0 },
+        { HAL_WAVE_DC, 0.0, 0.0, 512.0, 0.0 },
+        { HAL_WAVE_DC, 0.0, 0.0, 512.0, 0.0 }
+        } ;
+
+unsigned char   HAL_pins[HAL_PORTS] ;                   // all low : no button pressed
+
+unsigned long long      HAL_cycles ;
+unsigned char   HAL_level ;
+unsigned long   HAL_interrupts[3] ;
+unsigned long long      HAL_busy[3] ;
+double          HAL_hostIsr ;
+
+void    (*HAL_frameHook)() = 0 ;
+void    (*HAL_lineHook)(const unsigned char *pixels, unsigned char n) = 0 ;
+void    (*HAL_pinHook)(unsigned long long cycle, unsigned char video, unsigned char sync) = 0 ;
+void    (*HAL_txHook)(unsigned char b) = 0 ;
+
+static unsigned char    HAL_reg[HAL_SFRS] ;
+static HAL_TIMER        HAL_t0, HAL_t1, HAL_t2, HAL_t3 ;
+static unsigned char    HAL_t2post ;                    // TIMER 2 matches since last flag
+
+static unsigned char    HAL_adBusy ;                    // conversion running
+static unsigned long long       HAL_adSample ;          // end of acquisition
+static unsigned long long       HAL_adDone ;            // end of conversion
+static unsigned int     HAL_adCode ;                    // sampled input
+
+static unsigned long long       HAL_edge ;              // index of next input half period
+static unsigned char    HAL_ccp1pre ;                   // edges since last capture
+
+static unsigned long    HAL_noise = 1 ;                 // noise generator
+
+static unsigned char    HAL_txBusy ;                    // transmit shift register busy
+static unsigned long long       HAL_txEnd ;             // end of the stop bit
+static unsigned char    HAL_txFull ;                    // TXREG holds a byte
+static unsigned char    HAL_txData ;                    // byte in TXREG
+
+/*
+ * PAL_ISR asm registers
+ */
+static const unsigned char      *HAL_fsr0 ;
+static const unsigned char      *HAL_tblptr ;
+static unsigned char    HAL_w ;
+static unsigned char    HAL_carry ;
+static unsigned char    HAL_pixels[32] ;
+static unsigned char    HAL_pixelCnt ;
+
+/*********************
+ * TIMERS
+ *********************/
+
+/************************************
+ * HAL_count : current count of a timer, not wrapped
+ ***********************************/
+static unsigned long long       HAL_count(const HAL_TIMER *t)
+        {
+        return(t->on ? (HAL_cycles - t->zero) / t->pre : t->count) ;
+        }
+
+/************************************
+ * HAL_setCount : load a timer
+ ***********************************/
+static void     HAL_setCount(HAL_TIMER *t, unsigned long v)
+        {
+        if(t->on) t->zero = HAL_cycles - (unsigned long long)v * t->pre ;
+        else t->count = v ;
+        }
+
+/************************************
+ * HAL_setMode : start, stop or prescale a timer, the count is kept
+ ***********************************/
+static void     HAL_setMode(HAL_TIMER *t, unsigned char on, unsigned int pre)
+        {
+        unsigned long   c ;
+
+        c = HAL_count(t) ;
+        t->on = on ;
+        t->pre = pre ;
+        t->count = c ;
+        if(on) t->zero = HAL_cycles - (unsigned long long)c * pre ;
+        }
+
+/************************************
+ * HAL_ccp1Timer, HAL_ccp2Timer : time base of the CCP modules (T3CON.T3CCPx)
+ ***********************************/
+static HAL_TIMER        *HAL_ccp1Timer()
+        {
+        return((HAL_reg[HAL_T3CON] & 0x40) ? &HAL_t3 : &HAL_t1) ;
+        }
+
+static HAL_TIMER        *HAL_ccp2Timer()
+        {
+        return((HAL_reg[HAL_T3CON] & 0x48) ? &HAL_t3 : &HAL_t1) ;
+        }
+
+/*********************
+ * ANALOG INPUTS
+ *********************/
+
+/************************************
+ * HAL_input : 10 bits code of an analog input at a given cycle
+ ***********************************/
+unsigned int    HAL_input(unsigned char ch, unsigned long long cycle)
+        {
+        const HAL_SIGNAL        *s ;
+        double  ph, v ;
+
+        if(ch >= HAL_CHANNELS) return(0) ;
+        s = &HAL_signal[ch] ;
+
+        ph = fmod((double)cycle * s->freq / HAL_FCY, 1.0) ;
+        switch(s->wave)
+                {
+                case HAL_WAVE_SINE:     v = sin(2 * M_PI * ph) ; break ;
+                case HAL_WAVE_SQUARE:   v = (ph < 0.5) ? 1 : -1 ; break ;
+                case HAL_WAVE_TRIANGLE: v = (ph < 0.25) ? 4 * ph : (ph < 0.75) ? 2 - 4 * ph : 4 * ph - 4 ; break ;
+                case HAL_WAVE_SAW:      v = (ph < 0.5) ? 2 * ph : 2 * ph - 2 ; break ;
+                default:                v = 0 ; break ;
+                }
+        v = s->offset + s->amplitude * v ;
+        if(s->noise != 0)
+                {
+                HAL_noise = HAL_noise * 1103515245 + 12345 ;
+                v += s->noise * (((HAL_noise >> 16) & 0x7fff) / 16383.5 - 1) ;
+                }
+
+        if(v < 0) v = 0 ;
+        if(v > 1023) v = 1023 ;
+        return((unsigned int)(v + 0.5)) ;
+        }
+
+/************************************
+ * HAL_edgeAt : cycle of an edge of AN0 on the comparator (RC2)
+ * even edges are rising, odd ones falling
+ ***********************************/
+static unsigned long long       HAL_edgeAt(unsigned long long k)
+        {
+        if((HAL_signal[0].wave == HAL_WAVE_DC) || (HAL_signal[0].freq <= 0)) return(HAL_NEVER) ;
+
+        return((unsigned long long)ceil(k * (HAL_FCY / 2.0) / HAL_signal[0].freq)) ;
+        }
+
+/************************************
+ * HAL_adStart : start an A/D conversion with ADCON2 timing
+ ***********************************/
+static void     HAL_adStart()
+        {
+        static const unsigned char      tosc[8] = { 2, 8, 32, 40, 4, 16, 64, 40 } ;  // Tosc per TAD, RC is about 1.2 us
+        static const unsigned char      acqt[8] = { 0, 2, 4, 6, 8, 12, 16, 20 } ;    // acquisition TAD
+        unsigned int    t, a ;
+
+        if(!(HAL_reg[HAL_ADCON0] & 0x01) || HAL_adBusy) return ;
+
+        t = tosc[HAL_reg[HAL_ADCON2] & 7] ;
+        a = acqt[(HAL_reg[HAL_ADCON2] >> 3) & 7] ;
+
+        HAL_adBusy = 1 ;
+        HAL_adSample = HAL_cycles + (a * t + 3) / 4 ;
+        HAL_adDone = HAL_cycles + ((a + 11) * t + 3) / 4 ;
+        HAL_adCode = HAL_input((HAL_reg[HAL_ADCON0] >> 2) & 0x0f, HAL_adSample) ;
+        }
+
+/*********************
+ * EUSART
+ *********************/
+
+/************************************
+ * HAL_txFlags : TXIF when TXREG is empty, TRMT when the shift register is
+ ***********************************/
+static void     HAL_txFlags()
+        {
+        if((HAL_reg[HAL_TXSTA] & 0x20) && !HAL_txFull) HAL_reg[HAL_PIR1] |= 0x10 ;
+        else HAL_reg[HAL_PIR1] &= ~0x10 ;
+        if(HAL_txBusy) HAL_reg[HAL_TXSTA] &= ~0x02 ;
+        else HAL_reg[HAL_TXSTA] |= 0x02 ;
+        }
+
+/************************************
+ * HAL_txStart : shift a byte out, start bit, 8 or 9 bits, stop bit
+ * the baud rate generator counts SPBRG + 1 periods of Fosc / 4, 16 or 64
+ ***********************************/
+static void     HAL_txStart(unsigned char b)
+        {
+        unsigned int    brg, bit ;
+
+        brg = HAL_reg[HAL_SPBRG] + 1 ;
+        if(HAL_reg[HAL_BAUDCON] & 0x08) brg += HAL_reg[HAL_SPBRGH] << 8 ;      // BRG16
+        bit = brg * (((HAL_reg[HAL_BAUDCON] & 0x08) ? 1 : 4) * ((HAL_reg[HAL_TXSTA] & 0x04) ? 1 : 4)) ;
+
+        HAL_txBusy = 1 ;
+        HAL_txEnd = HAL_cycles + ((HAL_reg[HAL_TXSTA] & 0x40) ? 11 : 10) * bit ;
+        if(HAL_txHook) HAL_txHook(b) ;
+        }
+
+/*********************
+ * EVENTS
+ *********************/
+
+/************************************
+ * HAL_next : cycle of the next hardware event
+ ***********************************/
+static unsigned long long       HAL_next()
+        {
+        unsigned long long      n, e ;
+        HAL_TIMER       *t ;
+        unsigned int    ccpr ;
+
+        n = HAL_NEVER ;
+
+        if(HAL_t0.on)
+                {
+                e = HAL_t0.zero + ((HAL_reg[HAL_T0CON] & 0x40) ? 256ULL : 65536ULL) * HAL_t0.pre ;
+                if(e < n) n = e ;
+                }
+        if(HAL_t1.on)
+                {
+                e = HAL_t1.zero + 65536ULL * HAL_t1.pre ;
+                if(e < n) n = e ;
+                }
+        if(HAL_t2.on)
+                {
+                e = HAL_t2.zero + (HAL_reg[HAL_PR2] + 1ULL) * HAL_t2.pre ;
+                if(e < HAL_cycles) e = HAL_t2.zero + 256ULL * HAL_t2.pre ;     // PR2 below the count : wraps at 256
+                if(e < n) n = e ;
+                }
+        if(HAL_t3.on)
+                {
+                e = HAL_t3.zero + 65536ULL * HAL_t3.pre ;
+                if(e < n) n = e ;
+                }
+
+        /*
+         * CCP2 special event trigger
+         */
+        t = HAL_ccp2Timer() ;
+        ccpr = (HAL_reg[HAL_CCPR2H] << 8) | HAL_reg[HAL_CCPR2L] ;
+        if(((HAL_reg[HAL_CCP2CON] & 0x0f) == 0x0b) && t->on && (ccpr > HAL_count(t)))
+                {
+                e = t->zero + (unsigned long long)ccpr * t->pre ;
+                if(e < n) n = e ;
+                }
+
+        if(HAL_adBusy && (HAL_adDone < n)) n = HAL_adDone ;
+        if(HAL_txBusy && (HAL_txEnd < n)) n = HAL_txEnd ;
+
+        /*
+         * CCP1 capture mode
+         */
+        if(((HAL_reg[HAL_CCP1CON] & 0x0c) == 0x04) && HAL_ccp1Timer()->on)
+                {
+                e = HAL_edgeAt(HAL_edge) ;
+                if(e < n) n = e ;
+                }
+
+        return(n) ;
+        }
+
+/************************************
+ * HAL_apply : apply the hardware events due at HAL_cycles
+ ***********************************/
+static void     HAL_apply()
+        {
+        HAL_TIMER       *t ;
+        unsigned int    ccpr ;
+        unsigned long long      span ;
+
+        if(HAL_t0.on)
+                {
+                span = ((HAL_reg[HAL_T0CON] & 0x40) ? 256ULL : 65536ULL) * HAL_t0.pre ;
+                if(HAL_t0.zero + span <= HAL_cycles)
+                        {
+                        HAL_t0.zero += span ;
+                        HAL_reg[HAL_INTCON] |= 0x04 ;                   // TMR0IF
+                        }
+                }
+        if(HAL_t1.on && (HAL_t1.zero + 65536ULL * HAL_t1.pre <= HAL_cycles))
+                {
+                HAL_t1.zero += 65536ULL * HAL_t1.pre ;
+                HAL_reg[HAL_PIR1] |= 0x01 ;                             // TMR1IF
+                }
+        if(HAL_t2.on)
+                {
+                span = (HAL_reg[HAL_PR2] + 1ULL) * HAL_t2.pre ;
+                if(HAL_t2.zero + span <= HAL_cycles)
+                        {
+                        if(HAL_t2.zero + span == HAL_cycles)            // match
+                                {
+                                if(++HAL_t2post > ((HAL_reg[HAL_T2CON] >> 3) & 0x0f))
+                                        {
+                                        HAL_t2post = 0 ;
+                                        HAL_reg[HAL_PIR1] |= 0x02 ;     // TMR2IF
+                                        }
+                                HAL_t2.zero += span ;
+                                }
+                        else if(HAL_t2.zero + 256ULL * HAL_t2.pre <= HAL_cycles)
+                                {
+                                HAL_t2.zero += 256ULL * HAL_t2.pre ;    // missed match
+                                }
+                        }
+                }
+        if(HAL_t3.on && (HAL_t3.zero + 65536ULL * HAL_t3.pre <= HAL_cycles))
+                {
+                HAL_t3.zero += 65536ULL * HAL_t3.pre ;
+                HAL_reg[HAL_PIR2] |= 0x02 ;                             // TMR3IF
+                }
+
+        t = HAL_ccp2Timer() ;
+        ccpr = (HAL_reg[HAL_CCPR2H] << 8) | HAL_reg[HAL_CCPR2L] ;
+        if(((HAL_reg[HAL_CCP2CON] & 0x0f) == 0x0b) && t->on && ccpr
+                && (t->zero + (unsigned long long)ccpr * t->pre == HAL_cycles))
+                {
+                t->zero = HAL_cycles ;                                  // special event : reset the timer
+                HAL_reg[HAL_PIR2] |= 0x01 ;                             // CCP2IF
+                HAL_adStart() ;                                         // and start the A/D
+                }
+
+        if(HAL_adBusy && (HAL_adDone <= HAL_cycles))
+                {
+                HAL_adBusy = 0 ;
+                if(HAL_reg[HAL_ADCON2] & 0x80)                          // right justified
+                        {
+                        HAL_reg[HAL_ADRESH] = HAL_adCode >> 8 ;
+                        HAL_reg[HAL_ADRESL] = HAL_adCode ;
+                        }
+                else
+                        {
+                        HAL_reg[HAL_ADRESH] = HAL_adCode >> 2 ;
+                        HAL_reg[HAL_ADRESL] = HAL_adCode << 6 ;
+                        }
+                HAL_reg[HAL_PIR1] |= 0x40 ;                             // ADIF
+                }
+
+        if(HAL_txBusy && (HAL_txEnd <= HAL_cycles))
+                {
+                HAL_txBusy = 0 ;
+                if(HAL_txFull)                                          // TXREG to the shift register
+                        {
+                        HAL_txFull = 0 ;
+                        HAL_txStart(HAL_txData) ;
+                        }
+                HAL_txFlags() ;
+                }
+
+        while(HAL_edgeAt(HAL_edge) <= HAL_cycles)
+                {
+                unsigned char   mode, rising ;
+
+                mode = HAL_reg[HAL_CCP1CON] & 0x0f ;
+                rising = !(HAL_edge & 1) ;
+                HAL_edge++ ;
+                if(((mode & 0x0c) != 0x04) || !HAL_ccp1Timer()->on) continue ;
+                if((mode == 0x04) == rising) continue ;                 // 0100 : falling edges
+                if(++HAL_ccp1pre < ((mode == 0x07) ? 16 : (mode == 0x06) ? 4 : 1)) continue ;
+                HAL_ccp1pre = 0 ;
+
+                t = HAL_ccp1Timer() ;
+                ccpr = HAL_count(t) ;
+                HAL_reg[HAL_CCPR1H] = ccpr >> 8 ;
+                HAL_reg[HAL_CCPR1L] = ccpr ;
+                HAL_reg[HAL_PIR1] |= 0x04 ;                             // CCP1IF
+                }
+        }
+
+/************************************
+ * HAL_call : run an interrupt routine
+ ***********************************/
+static void     HAL_call(unsigned char level, void (*isr)())
+        {
+        unsigned char   prev ;
+
+        std::chrono::steady_clock::time_point   t ;
+
+        prev = HAL_level ;
+        HAL_level = level ;
+        HAL_interrupts[level]++ ;
+        if(prev == 0) t = std::chrono::steady_clock::now() ;
+        HAL_tick(HAL_ENTRY_CYCLES) ;
+        isr() ;
+        HAL_tick(HAL_RETFIE_CYCLES) ;
+        if(prev == 0) HAL_hostIsr += std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count() ;
+        HAL_level = prev ;
+        }
+
+/************************************
+ * HAL_poll : dispatch pending interrupts
+ ***********************************/
+static void     HAL_poll()
+        {
+        unsigned char   intcon, p1, p2, t0, hi, lo ;
+
+        for(;;)
+                {
+                intcon = HAL_reg[HAL_INTCON] ;
+                t0 = (intcon & 0x20) && (intcon & 0x04) ;
+                p1 = HAL_reg[HAL_PIR1] & HAL_reg[HAL_PIE1] ;
+                p2 = HAL_reg[HAL_PIR2] & HAL_reg[HAL_PIE2] ;
+
+                if(HAL_reg[HAL_RCON] & 0x80)                            // IPEN : two levels
+                        {
+                        hi = (t0 && (HAL_reg[HAL_INTCON2] & 0x04)) || (p1 & HAL_reg[HAL_IPR1]) || (p2 & HAL_reg[HAL_IPR2]) ;
+                        lo = (t0 && !(HAL_reg[HAL_INTCON2] & 0x04)) || (p1 & ~HAL_reg[HAL_IPR1]) || (p2 & ~HAL_reg[HAL_IPR2]) ;
+                        hi = hi && (intcon & 0x80) ;
+                        lo = lo && (intcon & 0x80) && (intcon & 0x40) ;
+                        }
+                else
+                        {
+                        hi = (intcon & 0x80) && (t0 || ((intcon & 0x40) && (p1 || p2))) ;
+                        lo = 0 ;
+                        }
+
+                if(hi && (HAL_level < 2)) HAL_call(2, interrupt) ;
+                else if(lo && (HAL_level < 1)) HAL_call(1, interrupt_low) ;
+                else break ;
+                }
+        }
+
+/*********************
+ * CLOCK
+ *********************/
+
+/************************************************************
+ * HAL_reset : power on reset
+ */
+void    HAL_reset()
+        {
+        memset(HAL_reg, 0, sizeof(HAL_reg)) ;
+        HAL_reg[HAL_TRISA] = HAL_reg[HAL_TRISB] = HAL_reg[HAL_TRISC] = HAL_reg[HAL_TRISD] = HAL_reg[HAL_TRISE] = 0xff ;
+        HAL_reg[HAL_INTCON2] = 0xf5 ;
+        HAL_reg[HAL_IPR1] = HAL_reg[HAL_IPR2] = 0xff ;
+        HAL_reg[HAL_PR2] = 0xff ;
+        HAL_reg[HAL_T0CON] = 0xff ;
+        HAL_reg[HAL_TXSTA] = 0x02 ;
+
+        HAL_cycles = 0 ;
+        HAL_level = 0 ;
+        memset(HAL_interrupts, 0, sizeof(HAL_interrupts)) ;
+        memset(HAL_busy, 0, sizeof(HAL_busy)) ;
+        HAL_hostIsr = 0 ;
+
+        memset(&HAL_t0, 0, sizeof(HAL_t0)) ;
+        memset(&HAL_t1, 0, sizeof(HAL_t1)) ;
+        memset(&HAL_t2, 0, sizeof(HAL_t2)) ;
+        memset(&HAL_t3, 0, sizeof(HAL_t3)) ;
+        HAL_t0.pre = HAL_t1.pre = HAL_t2.pre = HAL_t3.pre = 1 ;
+        HAL_t0.on = 1 ;
+        HAL_t0.pre = 1 ;
+        HAL_t2post = 0 ;
+
+        HAL_adBusy = 0 ;
+        HAL_edge = 0 ;
+        HAL_ccp1pre = 0 ;
+        HAL_noise = 1 ;
+        HAL_pixelCnt = 0 ;
+        HAL_txBusy = 0 ;
+        HAL_txFull = 0 ;
+        }
+
+/************************************************************
+ * HAL_tick : run n instruction cycles
+ * hardware events are applied on time, interrupts are dispatched after
+ * each event, unless they are masked or a routine of the same level runs
+ */
+void    HAL_tick(unsigned int n)
+        {
+        unsigned long long      end, e ;
+
+        end = HAL_cycles + n ;
+        for(;;)
+                {
+                e = HAL_next() ;
+                if(e > end) break ;
+                if(e > HAL_cycles)
+                        {
+                        HAL_busy[HAL_level] += e - HAL_cycles ;
+                        HAL_cycles = e ;
+                        }
+                HAL_apply() ;
+                HAL_poll() ;
+                }
+        if(HAL_cycles < end)
+                {
+                HAL_busy[HAL_level] += end - HAL_cycles ;
+                HAL_cycles = end ;
+                }
+        HAL_poll() ;
+        }
+
+/************************************************************
+ * HAL_idle : run up to the next hardware event, for busy waits
+ */
+void    HAL_idle()
+        {
+        unsigned long long      e ;
+
+        e = HAL_next() ;
+        if((e == HAL_NEVER) || (e <= HAL_cycles)) HAL_tick(1) ;
+        else HAL_tick(e - HAL_cycles) ;
+        }
+
+/*********************
+ * SFR ACCESS
+ *********************/
+
+/************************************
+ * HAL_port : write a port latch, trace the video pins
+ * each write of PORTD or PORTE is traced, even when the pins keep
+ * their level : a pixel is a write of PORTD
+ ***********************************/
+static void     HAL_port(unsigned char id, unsigned char v)
+        {
+        if(id >= HAL_LATA) id -= HAL_LATA - HAL_PORTA ;
+        HAL_reg[id] = v ;
+        HAL_reg[id - HAL_PORTA + HAL_LATA] = v ;
+
+        if(HAL_pinHook && ((id == HAL_PORTD) || (id == HAL_PORTE)))
+                {
+                HAL_pinHook(HAL_cycles, HAL_reg[HAL_PORTD] & 1, HAL_reg[HAL_PORTE] & 1) ;
+                }
+        }
+
+/************************************************************
+ * HAL_read : read an SFR, one cycle
+ */
+unsigned char   HAL_read(unsigned char id)
+        {
+        unsigned char   v ;
+        unsigned long   c ;
+
+        switch(id)
+                {
+                case HAL_PORTA: case HAL_PORTB: case HAL_PORTC: case HAL_PORTD: case HAL_PORTE:
+                        v = HAL_reg[id] & ~HAL_reg[id - HAL_PORTA + HAL_TRISA] ;       // outputs read their latch
+                        v |= HAL_pins[id - HAL_PORTA] & HAL_reg[id - HAL_PORTA + HAL_TRISA] ;
+                        break ;
+                case HAL_TMR0L:
+                        c = HAL_count(&HAL_t0) ;
+                        HAL_t0.buf = c >> 8 ;
+                        v = c ;
+                        break ;
+                case HAL_TMR0H:
+                        v = HAL_t0.buf ;
+                        break ;
+                case HAL_TMR1L:
+                        c = HAL_count(&HAL_t1) ;
+                        HAL_t1.buf = c >> 8 ;                           // RD16 : TMR1H is latched
+                        v = c ;
+                        break ;
+                case HAL_TMR1H:
+                        v = (HAL_reg[HAL_T1CON] & 0x80) ? HAL_t1.buf : HAL_count(&HAL_t1) >> 8 ;
+                        break ;
+                case HAL_TMR2:
+                        v = HAL_count(&HAL_t2) ;
+                        break ;
+                case HAL_TMR3L:
+                        c = HAL_count(&HAL_t3) ;
+                        HAL_t3.buf = c >> 8 ;
+                        v = c ;
+                        break ;
+                case HAL_TMR3H:
+                        v = (HAL_reg[HAL_T3CON] & 0x80) ? HAL_t3.buf : HAL_count(&HAL_t3) >> 8 ;
+                        break ;
+                case HAL_ADCON0:
+                        v = (HAL_reg[id] & ~0x02) | (HAL_adBusy ? 0x02 : 0) ;
+                        break ;
+                default:
+                        v = HAL_reg[id] ;
+                        break ;
+                }
+
+        HAL_tick(1) ;
+        return(v) ;
+        }
+
+/************************************
+ * HAL_store : write an SFR, no cycle
+ ***********************************/
+static void     HAL_store(unsigned char id, unsigned char v)
+        {
+        static const unsigned char      pre2[4] = { 1, 4, 16, 16 } ;
+
+        switch(id)
+                {
+                case HAL_PORTA: case HAL_PORTB: case HAL_PORTC: case HAL_PORTD: case HAL_PORTE:
+                case HAL_LATA: case HAL_LATB: case HAL_LATC: case HAL_LATD: case HAL_LATE:
+                        HAL_port(id, v) ;
+                        return ;
+                case HAL_T0CON:
+                        HAL_reg[id] = v ;
+                        HAL_setMode(&HAL_t0, v >> 7, (v & 0x08) ? 1 : 2 << (v & 7)) ;
+                        return ;
+                case HAL_TMR0H:
+                        HAL_t0.buf = v ;
+                        return ;
+                case HAL_TMR0L:
+                        HAL_setCount(&HAL_t0, (HAL_t0.buf << 8) | v) ;
+                        return ;
+                case HAL_T1CON:
+                        HAL_reg[id] = v ;
+                        HAL_setMode(&HAL_t1, v & 1, 1 << ((v >> 4) & 3)) ;
+                        return ;
+                case HAL_TMR1H:
+                        HAL_t1.buf = v ;                                // written with TMR1L
+                        return ;
+                case HAL_TMR1L:
+                        HAL_setCount(&HAL_t1, (HAL_t1.buf << 8) | v) ;
+                        return ;
+                case HAL_T2CON:
+                        HAL_reg[id] = v ;
+                        HAL_setMode(&HAL_t2, (v >> 2) & 1, pre2[v & 3]) ;
+                        return ;
+                case HAL_TMR2:
+                        HAL_setCount(&HAL_t2, v) ;
+                        HAL_t2post = 0 ;
+                        return ;
+                case HAL_T3CON:
+                        HAL_reg[id] = v ;
+                        HAL_setMode(&HAL_t3, v & 1, 1 << ((v >> 4) & 3)) ;
+                        return ;
+                case HAL_TMR3H:
+                        HAL_t3.buf = v ;
+                        return ;
+                case HAL_TMR3L:
+                        HAL_setCount(&HAL_t3, (HAL_t3.buf << 8) | v) ;
+                        return ;
+                case HAL_CCP1CON:
+                        HAL_reg[id] = v ;
+                        HAL_ccp1pre = 0 ;
+                        return ;
+                case HAL_ADCON0:
+                        HAL_reg[id] = v & ~0x02 ;
+                        if(v & 0x02) HAL_adStart() ;                    // GO
+                        return ;
+                case HAL_TXSTA:
+                case HAL_PIR1:
+                        HAL_reg[id] = v ;
+                        HAL_txFlags() ;                                 // TRMT and TXIF are read only
+                        return ;
+                case HAL_TXREG:
+                        if(!(HAL_reg[HAL_TXSTA] & 0x20) || !(HAL_reg[HAL_RCSTA] & 0x80)) return ;     // TXEN, SPEN
+                        if(HAL_txBusy)
+                                {
+                                HAL_txFull = 1 ;
+                                HAL_txData = v ;
+                                }
+                        else
+                                {
+                                HAL_txStart(v) ;
+                                }
+                        HAL_txFlags() ;
+                        return ;
+                default:
+                        HAL_reg[id] = v ;
+                        return ;
+                }
+        }
+
+/************************************************************
+ * HAL_write : write an SFR, one cycle
+ */
+void    HAL_write(unsigned char id, unsigned char v)
+        {
+        HAL_store(id, v) ;
+        HAL_tick(1) ;
+        }
+
+/************************************************************
+ * HAL_writeBits : set or clear bits of an SFR, one cycle (BSF, BCF)
+ */
+void    HAL_writeBits(unsigned char id, unsigned char mask, unsigned char v)
+        {
+        unsigned char   r ;
+
+        switch(id)
+                {
+                case HAL_TMR0L: case HAL_TMR1L: case HAL_TMR2: case HAL_TMR3L:
+                        r = HAL_count((id == HAL_TMR0L) ? &HAL_t0 : (id == HAL_TMR1L) ? &HAL_t1 : (id == HAL_TMR2) ? &HAL_t2 : &HAL_t3) ;
+                        break ;
+                case HAL_ADCON0:
+                        r = HAL_reg[id] & ~0x02 ;
+                        break ;
+                default:
+                        r = HAL_reg[id] ;
+                        break ;
+                }
+
+        HAL_store(id, (r & ~mask) | v) ;
+        HAL_tick(1) ;
+        }
+
+/*********************
+ * PAL_ISR ASM
+ *********************/
+
+/************************************************************
+ * HAL_asmBorder : MOVFF _PAL_border, PORTD
+ * the right border ends the video line : HAL_lineHook gets its pixels
+ */
+void    HAL_asmBorder(unsigned char border)
+        {
+        HAL_tick(1) ;
+        HAL_port(HAL_PORTD, border) ;
+        HAL_tick(1) ;
+
+        if(HAL_pixelCnt)
+                {
+                if(HAL_lineHook) HAL_lineHook(HAL_pixels, HAL_pixelCnt) ;
+                HAL_pixelCnt = 0 ;
+                }
+        }
+
+/************************************************************
+ * HAL_asmHead : PAL_BLOCK_HEAD, 14 cycles
+ * FSR0 and TBLPTR are loaded, first byte and its overlay are written to PORTD
+ */
+void    HAL_asmHead(const unsigned char *pixels, const unsigned char *overlay)
+        {
+        HAL_fsr0 = pixels ;                     // MOVFF x 4, CLRF
+        HAL_tblptr = overlay ;
+        HAL_tick(9) ;
+        HAL_w = *HAL_fsr0++ ;                   // MOVF POSTINC0, W
+        HAL_tick(1) ;
+        HAL_reg[HAL_TABLAT] = *HAL_tblptr++ ;   // TBLRD*+
+        HAL_tick(2) ;
+        HAL_w |= HAL_reg[HAL_TABLAT] ;          // IORWF TABLAT, W
+        HAL_tick(1) ;
+
+        HAL_pixelCnt = 0 ;
+        HAL_asmLoad() ;                         // MOVWF PORTD
+        }
+
+/************************************
+ * HAL_rrcf : RRCF PORTD, F
+ ***********************************/
+static void     HAL_rrcf()
+        {
+        unsigned char   v, c ;
+
+        v = HAL_reg[HAL_PORTD] ;
+        c = v & 1 ;
+        HAL_port(HAL_PORTD, (v >> 1) | (HAL_carry << 7)) ;
+        HAL_carry = c ;
+        HAL_tick(1) ;
+        }
+
+/************************************************************
+ * HAL_asmShift : PAL_BLOCK_SHIFT, 19 cycles
+ * 7 shifts of PORTD while the next byte and its overlay are read
+ */
+void    HAL_asmShift()
+        {
+        HAL_w = *HAL_fsr0++ ;                   // MOVF POSTINC0, W
+        HAL_tick(2) ;                           // nop
+        HAL_rrcf() ;
+        HAL_tick(1) ;
+        HAL_rrcf() ;
+        HAL_tick(2) ;
+        HAL_rrcf() ;
+        HAL_tick(1) ;
+        HAL_rrcf() ;
+        HAL_reg[HAL_TABLAT] = *HAL_tblptr++ ;   // TBLRD*+
+        HAL_tick(2) ;
+        HAL_rrcf() ;
+        HAL_tick(1) ;
+        HAL_rrcf() ;
+        HAL_w |= HAL_reg[HAL_TABLAT] ;          // IORWF TABLAT, W
+        HAL_tick(2) ;
+        HAL_rrcf() ;
+        HAL_tick(1) ;
+        }
+
+/************************************************************
+ * HAL_asmLoad : PAL_BLOCK_LOAD, MOVWF PORTD
+ */
+void    HAL_asmLoad()
+        {
+        HAL_port(HAL_PORTD, HAL_w) ;
+        if(HAL_pixelCnt < sizeof(HAL_pixels)) HAL_pixels[HAL_pixelCnt++] = HAL_w ;
+        HAL_tick(1) ;
+        }
+
+/*********************
+ * mikroC BUILT-INS
+ *********************/
+void    Delay_us(unsigned int n)
+        {
+        HAL_tick(n * (HAL_FCY / 1000000L)) ;
+        }
+
+void    Delay_ms(unsigned int n)
+        {
+        while(n--) HAL_tick(HAL_FCY / 1000L) ;
+        }
+
+void    Delay_Cyc(unsigned char n)
+        {
+        HAL_tick(n * 10) ;
+        }
+
+/*
+ * select the channel, start and wait for the conversion, right justified result
+ */
+unsigned int    ADC_Read(unsigned char ch)
+        {
+        HAL_store(HAL_ADCON0, ((ch & 0x0f) << 2) | 0x01) ;
+        HAL_reg[HAL_ADCON2] |= 0x80 ;
+        HAL_store(HAL_ADCON0, HAL_reg[HAL_ADCON0] | 0x02) ;
+        while(HAL_adBusy) HAL_idle() ;
+        return((HAL_reg[HAL_ADRESH] << 8) | HAL_reg[HAL_ADRESL]) ;
+        }
+
+int     sinE3(unsigned int angle)
+        {
+        return((int)floor(sin(angle * M_PI / 180) * 1000 + 0.5)) ;
+        }
+
+int     cosE3(unsigned int angle)
+        {
+        return((int)floor(cos(angle * M_PI / 180) * 1000 + 0.5)) ;
+        }
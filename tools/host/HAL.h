@@ -0,0 +1,238 @@
+/*
+ * file         : HAL.h
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      host stand-in for the mikroC PIC18F4550 environment, so that the
+ *      firmware sources build and run natively. It is force-included
+ *      before each firmware source (g++ -include HAL.h), see PAL_bench.cpp.
+ *
+ *      SFRs are objects : reading or writing one goes through HAL.cpp,
+ *      which emulates the parts of the chip the firmware uses on an
+ *      instruction cycle clock :
+ *      - TIMER 0 line interrupt, TIMER 2 sync pulses (PAL_library)
+ *      - TIMER 1 free running time base with RD16 buffer, CCP1 captures
+ *        of the input edges on RC2 (FREQ_library, ACQ_edge)
+ *      - TIMER 3 and CCP2 special event trigger, A/D converter with
+ *        ACQT/ADCS timing and ADFM justification (AD_library, ACQ_library)
+ *      - EUSART transmitter at its baud rate (TXIF, TRMT), the bytes go
+ *        to HAL_txHook (EXP_library)
+ *      - high and low priority interrupts, dispatched between two SFR
+ *        accesses to interrupt() and interrupt_low()
+ *      the analog inputs are scripted signals (HAL_signal), the digital
+ *      ones are levels (HAL_pins).
+ *
+ *      cost model : an SFR access is one instruction cycle, other C code
+ *      takes no time, the asm of PAL_ISR is replaced by HAL_asm* with its
+ *      exact instruction cycles. Timings are only exact for the asm parts.
+ *
+ *      integers : int and long are 32 and 64 bits on the host, 16 and 32
+ *      bits for mikroC. The firmware arithmetic that relies on their wrap
+ *      around uses INT_U16 and INT_U32 (INT_types.h), which are exact
+ *      on both.
+ *
+ *      the firmware never ends : its busy waits (PAL_vblankWait, ACQ_ready)
+ *      are replaced by host versions that run the chip until the
+ *      condition is met, and call HAL_frameHook on each new frame.
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#include        <string.h>
+
+/*
+ * mikroC entry point is renamed, the host program has its own main
+ */
+#define main    HAL_firmwareMain
+
+#define HAL_FCY                 8000000L        // instruction clock (Hz)
+
+#define HAL_ENTRY_CYCLES        3       // interrupt latency
+#define HAL_RETFIE_CYCLES       2       // return from interrupt
+
+/*
+ * SFR identifiers
+ */
+enum
+        {
+        HAL_PORTA, HAL_PORTB, HAL_PORTC, HAL_PORTD, HAL_PORTE,
+        HAL_TRISA, HAL_TRISB, HAL_TRISC, HAL_TRISD, HAL_TRISE,
+        HAL_LATA, HAL_LATB, HAL_LATC, HAL_LATD, HAL_LATE,
+        HAL_INTCON, HAL_INTCON2, HAL_INTCON3, HAL_RCON,
+        HAL_PIR1, HAL_PIR2, HAL_PIE1, HAL_PIE2, HAL_IPR1, HAL_IPR2,
+        HAL_ADCON0, HAL_ADCON1, HAL_ADCON2, HAL_ADRESH, HAL_ADRESL,
+        HAL_T0CON, HAL_TMR0L, HAL_TMR0H,
+        HAL_T1CON, HAL_TMR1L, HAL_TMR1H,
+        HAL_T2CON, HAL_PR2, HAL_TMR2,
+        HAL_T3CON, HAL_TMR3L, HAL_TMR3H,
+        HAL_CCP1CON, HAL_CCPR1L, HAL_CCPR1H, HAL_CCP2CON, HAL_CCPR2L, HAL_CCPR2H,
+        HAL_TABLAT, HAL_TBLPTRL, HAL_TBLPTRH, HAL_TBLPTRU,
+        HAL_TXSTA, HAL_RCSTA, HAL_BAUDCON, HAL_SPBRG, HAL_SPBRGH, HAL_TXREG, HAL_RCREG,
+        HAL_CMCON, HAL_CVRCON,
+        HAL_SFRS
+        } ;
+
+unsigned char   HAL_read(unsigned char id) ;
+void    HAL_write(unsigned char id, unsigned char v) ;
+void    HAL_writeBits(unsigned char id, unsigned char mask, unsigned char v) ;
+
+/*
+ * one bit of an SFR, reg.F0 or reg.TMR2IF : all bits of an SFR are
+ * empty members of a union at its start, so a bit finds its SFR at its
+ * own address
+ */
+struct  HAL_sfr ;
+
+template<int N> struct  HAL_bitAt
+        {
+        inline operator unsigned char() const ;
+        inline HAL_bitAt &operator=(unsigned int v) ;
+        inline HAL_bitAt &operator=(const HAL_bitAt &b) { return(*this = (unsigned int)(unsigned char)b) ; }
+        } ;
+
+/*
+ * bit names of the SFRs the firmware uses, and their position
+ */
+#define HAL_BITS(B)\
+        B(F0, 0) B(F1, 1) B(F2, 2) B(F3, 3) B(F4, 4) B(F5, 5) B(F6, 6) B(F7, 7)\
+        /* INTCON, INTCON2, RCON */\
+        B(GIE, 7) B(GIEH, 7) B(PEIE, 6) B(GIEL, 6) B(TMR0IE, 5) B(T0IE, 5) B(INT0IE, 4) B(RBIE, 3)\
+        B(TMR0IF, 2) B(T0IF, 2) B(INT0IF, 1) B(RBIF, 0) B(RBPU, 7) B(INTEDG0, 6) B(TMR0IP, 2) B(IPEN, 7)\
+        /* PIR1, PIE1, IPR1, PIR2... */\
+        B(ADIF, 6) B(ADIE, 6) B(ADIP, 6) B(RCIF, 5) B(RCIE, 5) B(RCIP, 5) B(TXIF, 4) B(TXIE, 4) B(TXIP, 4)\
+        B(CCP1IF, 2) B(CCP1IE, 2) B(CCP1IP, 2) B(TMR2IF, 1) B(TMR2IE, 1) B(TMR2IP, 1)\
+        B(TMR1IF, 0) B(TMR1IE, 0) B(TMR1IP, 0) B(TMR3IF, 1) B(TMR3IE, 1) B(TMR3IP, 1)\
+        B(CCP2IF, 0) B(CCP2IE, 0) B(CCP2IP, 0)\
+        /* ADCON0, ADCON2 */\
+        B(ADON, 0) B(GO, 1) B(DONE, 1) B(GO_DONE, 1) B(CHS0, 2) B(CHS1, 3) B(CHS2, 4) B(CHS3, 5) B(ADFM, 7)\
+        /* timers */\
+        B(TMR0ON, 7) B(T08BIT, 6) B(PSA, 3) B(TMR1ON, 0) B(TMR1CS, 1) B(TMR2ON, 2) B(TMR3ON, 0) B(TMR3CS, 1)\
+        B(T3CCP1, 3) B(T3CCP2, 6) B(RD16, 7)\
+        /* EUSART */\
+        B(TX9, 6) B(TXEN, 5) B(SYNC, 4) B(BRGH, 2) B(TRMT, 1) B(SPEN, 7) B(CREN, 4) B(FERR, 2) B(OERR, 1)\
+        B(BRG16, 3)
+
+#define HAL_BIT_MEMBER(name, n) HAL_bitAt<n> name ;
+
+struct  HAL_sfr
+        {
+        union
+                {
+                HAL_BITS(HAL_BIT_MEMBER)
+                } ;
+        unsigned char   id ;
+
+        explicit HAL_sfr(unsigned char i) : id(i) { }
+
+        operator unsigned char() const { return(HAL_read(id)) ; }
+        HAL_sfr &operator=(unsigned int v) { HAL_write(id, (unsigned char)v) ; return(*this) ; }
+        HAL_sfr &operator=(const HAL_sfr &r) { HAL_write(id, HAL_read(r.id)) ; return(*this) ; }
+        HAL_sfr &operator|=(unsigned int v) { HAL_write(id, (unsigned char)(HAL_read(id) | v)) ; return(*this) ; }
+        HAL_sfr &operator&=(unsigned int v) { HAL_write(id, (unsigned char)(HAL_read(id) & v)) ; return(*this) ; }
+        HAL_sfr &operator^=(unsigned int v) { HAL_write(id, (unsigned char)(HAL_read(id) ^ v)) ; return(*this) ; }
+        HAL_sfr &operator>>=(unsigned int n) { HAL_write(id, HAL_read(id) >> n) ; return(*this) ; }
+        HAL_sfr &operator<<=(unsigned int n) { HAL_write(id, HAL_read(id) << n) ; return(*this) ; }
+        HAL_sfr &operator++() { HAL_write(id, HAL_read(id) + 1) ; return(*this) ; }
+        HAL_sfr &operator--() { HAL_write(id, HAL_read(id) - 1) ; return(*this) ; }
+        unsigned char   operator++(int) { unsigned char v = HAL_read(id) ; HAL_write(id, v + 1) ; return(v) ; }
+        unsigned char   operator--(int) { unsigned char v = HAL_read(id) ; HAL_write(id, v - 1) ; return(v) ; }
+        } ;
+
+template<int N> inline  HAL_bitAt<N>::operator unsigned char() const
+        {
+        return((HAL_read(((const HAL_sfr *)this)->id) >> N) & 1) ;
+        }
+
+template<int N> inline  HAL_bitAt<N> &HAL_bitAt<N>::operator=(unsigned int v)
+        {
+        HAL_writeBits(((HAL_sfr *)this)->id, 1 << N, v ? 1 << N : 0) ;
+        return(*this) ;
+        }
+
+#define HAL_SFR_EXTERN(name)    extern HAL_sfr name ;
+#define HAL_SFR_LIST(S)\
+        S(PORTA) S(PORTB) S(PORTC) S(PORTD) S(PORTE) S(TRISA) S(TRISB) S(TRISC) S(TRISD) S(TRISE)\
+        S(LATA) S(LATB) S(LATC) S(LATD) S(LATE) S(INTCON) S(INTCON2) S(INTCON3) S(RCON)\
+        S(PIR1) S(PIR2) S(PIE1) S(PIE2) S(IPR1) S(IPR2) S(ADCON0) S(ADCON1) S(ADCON2) S(ADRESH) S(ADRESL)\
+        S(T0CON) S(TMR0L) S(TMR0H) S(T1CON) S(TMR1L) S(TMR1H) S(T2CON) S(PR2) S(TMR2)\
+        S(T3CON) S(TMR3L) S(TMR3H) S(CCP1CON) S(CCPR1L) S(CCPR1H) S(CCP2CON) S(CCPR2L) S(CCPR2H)\
+        S(TABLAT) S(TBLPTRL) S(TBLPTRH) S(TBLPTRU) S(TXSTA) S(RCSTA) S(BAUDCON) S(SPBRG) S(SPBRGH)\
+        S(TXREG) S(RCREG) S(CMCON) S(CVRCON)
+
+HAL_SFR_LIST(HAL_SFR_EXTERN)
+
+/*
+ * scripted analog input
+ */
+#define HAL_WAVE_DC             0
+#define HAL_WAVE_SINE           1
+#define HAL_WAVE_SQUARE         2
+#define HAL_WAVE_TRIANGLE       3
+#define HAL_WAVE_SAW            4
+
+#define HAL_CHANNELS            4       // AN0 to AN3
+
+typedef struct
+        {
+        unsigned char   wave ;          // HAL_WAVE_*
+        double          freq ;          // Hz
+        double          amplitude ;     // peak, in 10 bits A/D codes
+        double          offset ;        // center, in 10 bits A/D codes
+        double          noise ;         // peak, in 10 bits A/D codes
+        } HAL_SIGNAL ;
+
+extern  HAL_SIGNAL      HAL_signal[HAL_CHANNELS] ;     // AN0 is also the comparator input on RC2
+
+/*
+ * digital inputs : level of the pins of PORTA to PORTE, read where TRIS is 1
+ */
+#define HAL_PORTS               5
+
+extern  unsigned char   HAL_pins[HAL_PORTS] ;
+
+/*
+ * emulated chip
+ */
+extern  unsigned long long      HAL_cycles ;            // instruction cycles since reset
+extern  unsigned char   HAL_level ;                     // 0 main loop, 1 low, 2 high priority interrupt
+extern  unsigned long   HAL_interrupts[3] ;             // interrupt calls, per level
+extern  unsigned long long      HAL_busy[3] ;           // instruction cycles, per level
+extern  double          HAL_hostIsr ;                   // host seconds in interrupt routines
+
+extern  void    (*HAL_frameHook)() ;                    // called by the host PAL_vblankWait on each frame
+extern  void    (*HAL_lineHook)(const unsigned char *pixels, unsigned char n) ;   // bytes shifted out by one PAL_ISR video line
+extern  void    (*HAL_pinHook)(unsigned long long cycle, unsigned char video, unsigned char sync) ;       // PORTD or PORTE write
+extern  void    (*HAL_txHook)(unsigned char b) ;        // byte sent by the EUSART
+
+void    HAL_reset() ;
+void    HAL_tick(unsigned int n) ;
+void    HAL_idle() ;
+unsigned int    HAL_input(unsigned char ch, unsigned long long cycle) ;
+
+/*
+ * PAL_ISR asm, with the same instruction cycles
+ */
+void    HAL_asmBorder(unsigned char border) ;
+void    HAL_asmHead(const unsigned char *pixels, const unsigned char *overlay) ;
+void    HAL_asmShift() ;
+void    HAL_asmLoad() ;
+
+/*
+ * mikroC built-ins
+ */
+void    Delay_us(unsigned int n) ;
+void    Delay_ms(unsigned int n) ;
+void    Delay_Cyc(unsigned char n) ;
+unsigned int    ADC_Read(unsigned char ch) ;
+int     sinE3(unsigned int angle) ;
+int     cosE3(unsigned int angle) ;
+
+/*
+ * mikroC interrupt vectors, in the firmware main.c
+ */
+void    interrupt() ;
+void    interrupt_low() ;
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * file         : INTERP_check.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      host check of the INTERP library against double precision
+ *      interpolation : records of sines from 2.5 to 64 samples per period,
+ *      of a square and of noise are interpolated by INTERP_next at each
+ *      upsampling factor, from every start sample, and each column is
+ *      compared with
+ *      - the straight line between the two samples around it (INTERP_LINEAR)
+ *      - the 8 taps Lanczos sum of the same window, in double precision,
+ *        clipped to the sample range (INTERP_SINC)
+ *      the errors come from the 1/128 coefficients and the rounding of
+ *      the firmware. The largest error of each mode is shown, the exit
+ *      code is 1 if one is above its limit.
+ *
+ * build & usage :
+ *      g++ -O2 -Ifirmware/src -o INTERP_check tools/host/INTERP_check.cpp \
+ *              -x c++ -funsigned-char firmware/src/INTERP_library.c firmware/src/INTERP_table.c
+ *
+ *      ./INTERP_check
+ */
+
+#include        "ACQ_library.h"
+#include        "INTERP_library.h"
+
+#include        <cmath>
+#include        <cstdio>
+#include        <cstdlib>
+
+#define CHECK_COLUMNS           128     // columns per screen
+#define CHECK_LINEAR_MAX        1.0     // largest error allowed (LSB), the firmware truncates
+#define CHECK_SINC_MAX          2.5     // largest error allowed (LSB), coefficients in 1/128
+
+unsigned char   ACQ_buffer[ACQ_DEPTH] ;         // the record, INTERP_library reads it
+
+/*
+ * sin(pi x) / (pi x)
+ */
+static double   check_sinc(double x)
+        {
+        if(fabs(x) < 1e-9) return(1.0) ;
+
+        return(sin(M_PI * x) / (M_PI * x)) ;
+        }
+
+/*
+ * Lanczos kernel, as wide as the taps, as tools/INTERP_table.cpp
+ */
+static double   check_lanczos(double x)
+        {
+        const double    a = INTERP_TAPS / 2 ;
+
+        if(fabs(x) >= a) return(0.0) ;
+
+        return(check_sinc(x) * check_sinc(x / a)) ;
+        }
+
+/*
+ * sample i of the record, the ends repeat as in INTERP_library
+ */
+static double   check_sample(unsigned char first, int i)
+        {
+        if(i < 0) i = 0 ;
+        if(i > ACQ_DEPTH - 1) i = ACQ_DEPTH - 1 ;
+
+        return(ACQ_SAMPLE(first, i)) ;
+        }
+
+/*
+ * column p / 2^shift after sample k, in double precision
+ */
+static double   check_column(unsigned char first, int k, unsigned char p, unsigned char shift, unsigned char mode)
+        {
+        double  f, y ;
+        int     t ;
+
+        f = (double)p / (1 << shift) ;
+        if(p == 0) return(check_sample(first, k)) ;
+
+        if(mode == INTERP_LINEAR)
+                {
+                return(check_sample(first, k) * (1.0 - f) + check_sample(first, k + 1) * f) ;
+                }
+
+        y = 0.0 ;
+        for(t = 0 ; t < INTERP_TAPS ; t++)
+                {
+                y += check_lanczos(t - 3 - f) * (check_sample(first, k - 3 + t) - 128.0) ;
+                }
+        y += 128.0 ;
+        if(y < 0.0) y = 0.0 ;
+        if(y > 255.0) y = 255.0 ;
+
+        return(y) ;
+        }
+
+/*
+ * largest error of a mode over all the shifts and start samples of the record
+ */
+static double   check_record(unsigned char first, unsigned char mode)
+        {
+        double          e, worst ;
+        unsigned char   shift ;
+        int             from, c ;
+
+        worst = 0.0 ;
+        for(shift = 1 ; shift <= INTERP_SHIFT_MAX ; shift++)
+                {
+                for(from = 0 ; from < ACQ_DEPTH ; from++)
+                        {
+                        INTERP_begin(first, from, shift, mode) ;
+                        for(c = 0 ; c < CHECK_COLUMNS ; c++)
+                                {
+                                e = fabs(INTERP_next() - check_column(first, from + (c >> shift), c & ((1 << shift) - 1), shift, mode)) ;
+                                if(e > worst) worst = e ;
+                                }
+                        }
+                }
+
+        return(worst) ;
+        }
+
+int     main()
+        {
+        static const double     periods[] = { 2.5, 3.0, 4.0, 6.0, 8.0, 16.0, 64.0 } ;
+        double          linear, sinc, e ;
+        unsigned int    n, i ;
+        unsigned char   first ;
+
+        linear = 0.0 ;
+        sinc = 0.0 ;
+        srand(1) ;
+        for(n = 0 ; n < sizeof(periods) / sizeof(periods[0]) + 2 ; n++)
+                {
+                first = rand() & ACQ_MASK ;     // the record may start anywhere in the buffer
+                for(i = 0 ; i < ACQ_DEPTH ; i++)
+                        {
+                        if(n < sizeof(periods) / sizeof(periods[0]))
+                                {
+                                e = 128.0 + 120.0 * sin(2.0 * M_PI * i / periods[n] + 0.3) ;
+                                }
+                        else if(n == sizeof(periods) / sizeof(periods[0]))
+                                {
+                                e = (i & 8) ? 240.0 : 16.0 ;            // square, the sinc overshoots are clipped
+                                }
+                        else
+                                {
+                                e = rand() & 0xff ;                     // noise
+                                }
+                        ACQ_SAMPLE(first, i) = (unsigned char)lround(e) ;
+                        }
+
+                e = check_record(first, INTERP_LINEAR) ;
+                if(e > linear) linear = e ;
+                e = check_record(first, INTERP_SINC) ;
+                if(e > sinc) sinc = e ;
+                }
+
+        printf("linear       %.2f LSB %s\n", linear, (linear <= CHECK_LINEAR_MAX) ? "ok" : "differs") ;
+        printf("sinc         %.2f LSB %s\n", sinc, (sinc <= CHECK_SINC_MAX) ? "ok" : "differs") ;
+
+        return(((linear <= CHECK_LINEAR_MAX) && (sinc <= CHECK_SINC_MAX)) ? 0 : 1) ;
+        }
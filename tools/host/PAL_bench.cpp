@@ -0,0 +1,881 @@
+/*
+ * file         : PAL_bench.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      host build of the firmware, on the emulated chip of HAL.cpp
+ *      two builds of the same source :
+ *      - firmware : main.c runs unchanged with its libraries, the analog
+ *        input is a scripted signal. The bench runs it for some frames,
+ *        captures the picture PAL_ISR shifts out on PORTD, and reports the
+ *        host time per frame and the emulated cycles per interrupt level.
+ *        The readouts of the last frame are checked against the input :
+ *        the frequency to the last digit (sine 50 Hz is "50.00 Hz"), the
+ *        peak to peak tension within two sample codes. The run ends with
+ *        the acquisition stopped and an A/D sequence of AN3, AN1 and AN2
+ *        at dc levels : AD_ISR must get each result, before ACQ_ISR.
+ *        The bytes of the EUSART (exported records) can be written to a pty.
+ *        The buttons can be pressed after the frames, to check the zoom
+ *        and the pan of the deep record.
+ *      - PAL_SCREEN : the drawing primitives on a full PAL_screen. The
+ *        bench times each primitive (calls per second, host), draws one
+ *        scene per primitive and a full frame redraw (fill, curve, text),
+ *        and checks that PAL_ISR shows PAL_screen as it is.
+ *      pictures are PBM files (P4), the first pixel of a line is the
+ *      leftmost one : golden dumps are compared pixel for pixel.
+ *
+ * build & usage :
+ *      F="-x c++ -Wall -Wextra -funsigned-char -DPAL_HOST -include tools/host/HAL.h -Ifirmware/src"
+ *
+ *      g++ -O2 -o PAL_bench tools/host/PAL_bench.cpp tools/host/PAL_video.cpp tools/host/HAL.cpp \
+ *              tools/host/PAL_host.cpp tools/host/ACQ_host.cpp \
+ *              $F firmware/src/main.c firmware/src/PAL_assets.c firmware/src/FREQ_library.c \
+ *              firmware/src/MEAS_library.c firmware/src/FMT_library.c firmware/src/PROF_library.c \
+ *              firmware/src/EXP_library.c firmware/src/DEEP_library.c \
+ *              firmware/src/INTERP_library.c firmware/src/INTERP_table.c firmware/src/AD_library.c
+ *      g++ -O2 -DPAL_SCREEN -o PAL_screen tools/host/PAL_bench.cpp tools/host/HAL.cpp \
+ *              tools/host/PAL_host.cpp $F -DPAL_SCREEN firmware/src/PAL_assets.c
+ *
+ *      both build without warnings. The conversion pass checks the firmware
+ *      sources for the implicit narrowing and sign conversions, which a
+ *      16 bits int target does silently, it must not show any warning :
+ *              g++ -fsyntax-only -Wconversion -Wsign-conversion $F \
+ *                      $(find firmware/src -name '*.c' ! -name bench.c)
+ *              g++ -fsyntax-only -Wconversion -Wsign-conversion $F -DPROF -DPROF_LINE \
+ *                      $(find firmware/src -name '*.c' ! -name bench.c)
+ *              g++ -fsyntax-only -Wconversion -Wsign-conversion $F -DPAL_SCREEN \
+ *                      firmware/src/bench.c firmware/src/PAL_library.c
+ *
+ *      ./PAL_bench [-f frames] [-s wave,freq,amp,offset[,noise]] [-w dir] [-c dir]
+ *                  [-k key[,key...]] [-v] [-j cycles] [-S] [-o trace] [-t trace] [-p frame.pgm] [-x file]
+ *      ./PAL_screen [-n calls] [-w dir] [-c dir]
+ *
+ *      -f frames : frames to run, default 25 (1 s)
+ *      -s signal : AN0 input, wave is dc, sine, square, triangle or saw,
+ *                  freq in Hz, amplitude, offset and noise in 10 bits codes,
+ *                  default is sine,50,400,512
+ *      -k keys : buttons pressed one after the other after the frames, zoom,
+ *                back or forward, each one is held for 4 frames and
+ *                released for 4, the pictures after each key are key1,
+ *                key2..., firmware is the one before the first key
+ *      -v : record the video pins and check them against the PAL standard
+ *           (PAL_video.cpp), decode the picture back and compare it with
+ *           the scan-out, it is the "video" picture
+ *      -j cycles : allowed pixel jitter, default 0
+ *      -S : strict, check the sync pulse widths too (simulator traces)
+ *      -o trace : write the video trace, implies -v
+ *      -t trace : analyse a trace file instead of running the firmware
+ *      -p frame.pgm : write the last frame as seen on the video output,
+ *                     one column per cycle, implies -v
+ *      -x file : write the bytes sent by the EUSART (exported records) to
+ *                a file or a pty, see EXP_decode.cpp
+ *      -n calls : calls per timed primitive, default 100000
+ *      -w dir : write the pictures to dir
+ *      -c dir : compare the pictures with the golden ones of dir,
+ *               exit code is 1 if one differs
+ *
+ *      golden dumps are in tools/host/golden, they are written with the
+ *      default options : compare with the same ones. Those of
+ *      tools/host/golden/keys are written with a slow sine, whose record
+ *      is longer than a screen :
+ *              ./PAL_bench -s sine,7,400,512 -k zoom,back,zoom,zoom,back,back,forward \
+ *                      -c tools/host/golden/keys
+ */
+
+#include        "HAL.h"
+#include        "PAL_library.h"
+#include        "ACQ_library.h"
+#include        "AD_library.h"
+#include        "FMT_library.h"
+#include        "MEAS_library.h"
+#include        "PROF_library.h"
+#include        "PAL_video.h"
+
+#undef  main
+
+#include        <cmath>
+#include        <cstdio>
+#include        <cstdlib>
+#include        <cstring>
+#include        <chrono>
+#include        <string>
+
+#define BENCH_Y         104                     // vertical pixels, as main.c
+#define BENCH_BYTES     (PAL_X / 8 * BENCH_Y)   // one picture
+#define BENCH_KEYS      16                      // -k : most keys
+#define BENCH_KEY_FRAMES        8               // -k : frames per key, it is held for the first half
+#define BENCH_SEQ               3               // channels of the A/D sequence
+#define BENCH_SEQ_CYCLES        2000            // longest A/D sequence, 3 conversions take 360 cycles
+
+extern  unsigned int    PAL_lineVideo ;
+extern  unsigned char   PAL_shift_y ;
+#ifndef PAL_SCREEN
+extern  char            frequency_display[] ;   // main.c readouts
+extern  char            tension_display[] ;
+#ifdef PROF_LINE
+extern  char            profile_display[] ;
+#endif
+#endif
+
+typedef std::chrono::steady_clock       bench_clock ;
+
+/***************
+ * RAM variables
+ ***************/
+static unsigned char    bench_shown[BENCH_BYTES] ;      // picture shifted out by PAL_ISR
+static std::string      bench_writeDir ;                // -w dir
+static std::string      bench_goldenDir ;               // -c dir
+static int              bench_diffs = 0 ;               // pictures that differ from the golden ones
+#ifdef PAL_SCREEN
+static unsigned long    bench_seed ;                    // primitive arguments
+#else
+static unsigned long    bench_frames ;                  // frames to run
+static unsigned char    bench_firmware[BENCH_BYTES] ;   // picture of the last frame before the keys
+static unsigned char    bench_keyShown[BENCH_KEYS][BENCH_BYTES] ;       // picture after each key
+static unsigned char    bench_key[BENCH_KEYS] ;         // -k : buttons pressed after the frames
+static unsigned char    bench_keys = 0 ;                // -k : number of keys
+static unsigned char    bench_keyAt ;                   // next key
+static unsigned char    bench_keyDown ;                 // a button is held
+static unsigned long    bench_keyFrame ;                // frame of the next press or release
+static unsigned char    bench_seqResults[BENCH_SEQ] ;   // AD_results of the sequence
+static unsigned char    bench_seqSingle ;               // result of AD_start
+static int              bench_seqDone ;                 // the sequence has ended
+static unsigned char    bench_video = 0 ;               // -v : video analysis
+static unsigned int     bench_jitter = 0 ;              // -j : allowed pixel jitter
+static int              bench_strict = 0 ;              // -S : check the pulse widths
+static const char       *bench_traceOut = 0 ;           // -o : trace file written
+static const char       *bench_traceIn = 0 ;            // -t : trace file analysed
+static const char       *bench_framePgm = 0 ;           // -p : frame image
+static FILE             *bench_export = 0 ;             // -x : EUSART bytes written
+static unsigned long long       bench_txBytes = 0 ;     // EUSART bytes sent
+#endif
+
+/*
+ * end of the run, thrown from the frame hook
+ */
+struct  bench_stop { } ;
+
+/************************************
+ * bench_seconds : host time since t
+ ***********************************/
+static double   bench_seconds(bench_clock::time_point t)
+        {
+        return(std::chrono::duration<double>(bench_clock::now() - t).count()) ;
+        }
+
+/************************************
+ * bench_scanLine : PAL_ISR line hook, one picture row is shown on two lines
+ ***********************************/
+static void     bench_scanLine(const unsigned char *pixels, unsigned char n)
+        {
+        unsigned int    row ;
+
+        if(PAL_lineVideo < PAL_shift_y) return ;
+        row = (PAL_lineVideo - PAL_shift_y) >> 1 ;
+        if((row >= BENCH_Y) || (n != PAL_X / 8)) return ;
+
+        memcpy(bench_shown + row * (PAL_X / 8), pixels, n) ;
+        }
+
+/************************************
+ * bench_pbm : P4 image of a picture, bit 0 of a screen byte is its
+ * leftmost pixel, bit 7 in PBM
+ ***********************************/
+static std::string      bench_pbm(const unsigned char *screen)
+        {
+        std::string     s ;
+        char            h[32] ;
+        unsigned int    i ;
+        unsigned char   b, r, k ;
+
+        sprintf(h, "P4\n%d %d\n", PAL_X, BENCH_Y) ;
+        s = h ;
+        for(i = 0 ; i < BENCH_BYTES ; i++)
+                {
+                b = screen[i] ;
+                r = 0 ;
+                for(k = 0 ; k < 8 ; k++)
+                        {
+                        r = (r << 1) | (b & 1) ;
+                        b >>= 1 ;
+                        }
+                s += (char)r ;
+                }
+        return(s) ;
+        }
+
+/************************************
+ * bench_picture : write a picture, or compare it with its golden dump
+ ***********************************/
+static void     bench_picture(const char *name, const unsigned char *screen)
+        {
+        std::string     pbm, file, golden ;
+        FILE            *f ;
+        char            buf[4096] ;
+        size_t          n ;
+
+        pbm = bench_pbm(screen) ;
+
+        if(!bench_writeDir.empty())
+                {
+                file = bench_writeDir + "/" + name + ".pbm" ;
+                f = fopen(file.c_str(), "wb") ;
+                if(!f)
+                        {
+                        fprintf(stderr, "PAL_bench: can't write %s\n", file.c_str()) ;
+                        exit(1) ;
+                        }
+                fwrite(pbm.data(), 1, pbm.size(), f) ;
+                fclose(f) ;
+                }
+
+        if(!bench_goldenDir.empty())
+                {
+                file = bench_goldenDir + "/" + name + ".pbm" ;
+                f = fopen(file.c_str(), "rb") ;
+                if(f)
+                        {
+                        while((n = fread(buf, 1, sizeof(buf), f)) > 0) golden.append(buf, n) ;
+                        fclose(f) ;
+                        }
+                if(golden != pbm)
+                        {
+                        bench_diffs++ ;
+                        printf("%-12s differs from %s\n", name, file.c_str()) ;
+                        }
+                else
+                        {
+                        printf("%-12s ok\n", name) ;
+                        }
+                }
+        }
+
+#ifdef PAL_SCREEN
+/*********************
+ * PAL_SCREEN BUILD
+ *********************/
+
+unsigned char   PAL_screen[BENCH_BYTES] ;
+
+/************************************
+ * bench_rand : pseudo random argument in [0;n[
+ ***********************************/
+static unsigned char    bench_rand(unsigned int n)
+        {
+        bench_seed = bench_seed * 1103515245 + 12345 ;
+        return(((bench_seed >> 16) & 0x7fff) % n) ;
+        }
+
+void    interrupt()
+        {
+        PAL_ISR() ;
+        }
+
+void    interrupt_low()
+        {
+        }
+
+/*
+ * one primitive call with pseudo random arguments
+ */
+#define BENCH_X         bench_rand(PAL_X)
+#define BENCH_R         bench_rand(BENCH_Y)
+#define BENCH_COLOR     bench_rand(3)
+
+static unsigned char    bench_text[] = "12.5 mV" ;
+
+static void     bench_setPixel()        { PAL_setPixel(BENCH_X, BENCH_R, BENCH_COLOR) ; }
+static void     bench_line()            { PAL_line(BENCH_X, BENCH_R, BENCH_X, BENCH_R, BENCH_COLOR) ; }
+static void     bench_hline()           { PAL_hline(BENCH_X, BENCH_X, BENCH_R, BENCH_COLOR) ; }
+static void     bench_vline()           { PAL_vline(BENCH_X, BENCH_R, BENCH_R, BENCH_COLOR) ; }
+static void     bench_box()             { PAL_box(BENCH_X, BENCH_R, BENCH_X, BENCH_R, BENCH_COLOR) ; }
+static void     bench_rectangle()       { PAL_rectangle(BENCH_X, BENCH_R, BENCH_X, BENCH_R, BENCH_COLOR) ; }
+static void     bench_circle()          { PAL_circle(BENCH_X, BENCH_R, bench_rand(32), BENCH_COLOR) ; }
+static void     bench_char()            { PAL_char(bench_rand(PAL_X - 6), bench_rand(BENCH_Y - 8), '0' + bench_rand(10), PAL_CHAR_STANDARD) ; }
+static void     bench_charDsize()       { PAL_char(bench_rand(PAL_X - 12), bench_rand(BENCH_Y - 16), '0' + bench_rand(10), PAL_CHAR_DSIZE) ; }
+static void     bench_write()           { PAL_write(bench_rand(BENCH_Y / 8), bench_rand(PAL_X / 6 - 7), bench_text, PAL_CHAR_STANDARD) ; }
+static void     bench_fill()            { PAL_fill(bench_rand(2) ? 0xff : 0) ; }
+
+static const struct
+        {
+        const char      *name ;
+        void            (*call)() ;
+        } bench_primitives[] =
+        {
+        { "setPixel",   bench_setPixel },
+        { "line",       bench_line },
+        { "hline",      bench_hline },
+        { "vline",      bench_vline },
+        { "box",        bench_box },
+        { "rectangle",  bench_rectangle },
+        { "circle",     bench_circle },
+        { "char",       bench_char },
+        { "charDsize",  bench_charDsize },
+        { "write",      bench_write },
+        { "fill",       bench_fill },
+        } ;
+
+/************************************
+ * bench_redraw : one full frame, as a curve display would draw it
+ ***********************************/
+static void     bench_redraw(unsigned int phase)
+        {
+        unsigned char   x, y, py ;
+
+        PAL_fill(0) ;
+        PAL_rectangle(0, 0, PAL_X - 1, BENCH_Y - 1, PAL_COLOR_WHITE) ;
+        py = BENCH_Y / 2 - sinE3(phase) * 40 / 1000 ;
+        for(x = 1 ; x < PAL_X ; x++)
+                {
+                y = BENCH_Y / 2 - sinE3((x * 360 / 64 + phase) % 360) * 40 / 1000 ;
+                PAL_line(x - 1, py, x, y, PAL_COLOR_WHITE) ;
+                py = y ;
+                }
+        PAL_write(0, 1, bench_text, PAL_CHAR_STANDARD) ;
+        PAL_write(11, 1, bench_text, PAL_CHAR_STANDARD) ;
+        }
+
+/************************************
+ * bench_scanOut : run the video for two frames, PAL_ISR must show PAL_screen
+ ***********************************/
+static int      bench_scanOut()
+        {
+        unsigned long   frame ;
+
+        HAL_reset() ;
+        RCON.IPEN = 1 ;                         // as ACQ_init : PAL is high priority
+        INTCON2.TMR0IP = 1 ;
+        INTCON.GIEL = 1 ;
+        PAL_init(BENCH_Y) ;
+        PAL_control(PAL_CNTL_START, PAL_CNTL_RENDER) ;
+
+        memset(bench_shown, 0x55, sizeof(bench_shown)) ;
+        HAL_lineHook = bench_scanLine ;
+        frame = PAL_frameCtr ;
+        while(PAL_frameCtr < frame + 2) HAL_tick(PAL_X * 4) ;
+        HAL_lineHook = 0 ;
+        PAL_control(PAL_CNTL_STOP, PAL_CNTL_BLANK) ;
+
+        return(memcmp(bench_shown, PAL_screen, BENCH_BYTES) == 0) ;
+        }
+
+static int      bench_run(unsigned long calls)
+        {
+        bench_clock::time_point t ;
+        double          s ;
+        unsigned int    i ;
+        unsigned long   n ;
+        unsigned char   k ;
+
+        PAL_init(BENCH_Y) ;
+
+        printf("%-12s %12s %10s\n", "primitive", "calls/s", "ns/call") ;
+        for(i = 0 ; i < sizeof(bench_primitives) / sizeof(bench_primitives[0]) ; i++)
+                {
+                bench_seed = 1 ;
+                t = bench_clock::now() ;
+                for(n = 0 ; n < calls ; n++) bench_primitives[i].call() ;
+                s = bench_seconds(t) ;
+                printf("%-12s %12.0f %10.1f\n", bench_primitives[i].name, calls / s, s * 1e9 / calls) ;
+                }
+
+        t = bench_clock::now() ;
+        for(n = 0 ; n < calls / 100 ; n++) bench_redraw(n % 360) ;
+        s = bench_seconds(t) / (calls / 100) ;
+        printf("%-12s %12.0f %10.1f   %.3f %% of a frame\n", "redraw", 1 / s, s * 1e9, s * 100 / 0.04) ;
+        printf("\n") ;
+
+        /*
+         * one scene of 32 calls per primitive, on a black screen
+         */
+        for(i = 0 ; i < sizeof(bench_primitives) / sizeof(bench_primitives[0]) ; i++)
+                {
+                PAL_fill(0) ;
+                bench_seed = 1 ;
+                for(k = 0 ; k < 32 ; k++) bench_primitives[i].call() ;
+                bench_picture(bench_primitives[i].name, PAL_screen) ;
+                }
+        bench_redraw(90) ;
+        bench_picture("redraw", PAL_screen) ;
+
+        if(!bench_scanOut())
+                {
+                printf("scan-out     PAL_ISR does not show PAL_screen\n") ;
+                return(1) ;
+                }
+        printf("scan-out     ok, %lu cycles per frame in PAL_ISR\n",
+                (unsigned long)(HAL_busy[2] / (PAL_frameCtr ? PAL_frameCtr : 1))) ;
+        bench_picture("scanout", bench_shown) ;
+
+        return(0) ;
+        }
+
+#else
+/*********************
+ * FIRMWARE BUILD
+ *********************/
+
+int     HAL_firmwareMain() ;
+
+/*
+ * buttons of main.c, high when pressed
+ */
+static const struct
+        {
+        const char      *name ;
+        unsigned char   port ;                  // HAL_pins index
+        unsigned char   mask ;
+        } bench_buttons[] =
+        {
+        { "zoom",       1, 0x20 },              // RB5
+        { "back",       1, 0x40 },              // RB6
+        { "forward",    1, 0x80 },              // RB7
+        } ;
+
+/*
+ * A/D sequence run after the frames, on inputs AN1 to AN3 set to dc levels
+ * (10 bits codes), out of order
+ */
+static const struct
+        {
+        unsigned char   channel ;
+        double          level ;
+        } bench_seq[BENCH_SEQ] =
+        {
+        { 3,    900.0 },
+        { 1,    100.0 },
+        { 2,    600.0 },
+        } ;
+
+/************************************
+ * bench_sequence : stop the acquisition, convert one channel with AD_start
+ * and the bench_seq channels with AD_sequence, as the main loop would
+ * the low priority interrupts go on : AD_ISR must take each conversion
+ * of the sequence before ACQ_ISR clears ADIF, or the sequence stalls
+ ***********************************/
+static void     bench_sequence()
+        {
+        unsigned char   ch[BENCH_SEQ] ;
+        unsigned long long      end ;
+        unsigned char   i ;
+
+        ACQ_control(ACQ_CNTL_STOP) ;
+        while(AD_busy()) HAL_idle() ;           // last sample of the acquisition
+
+        for(i = 0 ; i < BENCH_SEQ ; i++)
+                {
+                ch[i] = bench_seq[i].channel ;
+                HAL_signal[ch[i]].wave = HAL_WAVE_DC ;
+                HAL_signal[ch[i]].offset = bench_seq[i].level ;
+                HAL_signal[ch[i]].noise = 0 ;
+                }
+
+        AD_start(ch[0]) ;
+        while(AD_busy()) HAL_idle() ;
+        bench_seqSingle = AD_RESULT8 ;
+
+        AD_sequence(ch, BENCH_SEQ) ;
+        end = HAL_cycles + BENCH_SEQ_CYCLES ;
+        while(!AD_sequenceDone() && (HAL_cycles < end)) HAL_idle() ;
+        bench_seqDone = AD_sequenceDone() ;
+        memcpy(bench_seqResults, AD_results, BENCH_SEQ) ;
+        }
+
+/************************************
+ * bench_frame : frame hook, plays the keys after the frames and stops
+ * the firmware after the last one
+ * a key is held for BENCH_KEY_FRAMES / 2 frames and released for as
+ * many, the picture at the end is key1, key2...
+ * the main loop may skip frames while it waits for a record
+ ***********************************/
+static void     bench_frame()
+        {
+        if(bench_export) fflush(bench_export) ;
+        if(PAL_frameCtr < bench_keyFrame) return ;
+        bench_keyFrame = PAL_frameCtr + BENCH_KEY_FRAMES / 2 ;
+
+        if(bench_keyDown)
+                {
+                memset(HAL_pins, 0, sizeof(HAL_pins)) ;
+                bench_keyDown = 0 ;
+                return ;
+                }
+
+        if(bench_keyAt == 0)
+                {
+                memcpy(bench_firmware, bench_shown, BENCH_BYTES) ;
+                }
+        else
+                {
+                memcpy(bench_keyShown[bench_keyAt - 1], bench_shown, BENCH_BYTES) ;
+                }
+        if(bench_keyAt == bench_keys)
+                {
+                bench_sequence() ;
+                throw bench_stop() ;
+                }
+
+        HAL_pins[bench_buttons[bench_key[bench_keyAt]].port] |= bench_buttons[bench_key[bench_keyAt]].mask ;
+        bench_keyAt++ ;
+        bench_keyDown = 1 ;
+        }
+
+/************************************
+ * bench_keyList : -k key[,key...]
+ ***********************************/
+static int      bench_keyList(const char *arg)
+        {
+        char            name[16] ;
+        unsigned char   i ;
+        int             n ;
+
+        bench_keys = 0 ;
+        while(*arg)
+                {
+                if((sscanf(arg, "%15[a-z]%n", name, &n) != 1) || (bench_keys == BENCH_KEYS)) return(0) ;
+                for(i = 0 ; i < sizeof(bench_buttons) / sizeof(bench_buttons[0]) ; i++)
+                        {
+                        if(strcmp(name, bench_buttons[i].name) == 0) break ;
+                        }
+                if(i == sizeof(bench_buttons) / sizeof(bench_buttons[0])) return(0) ;
+                bench_key[bench_keys++] = i ;
+                arg += n ;
+                if(*arg == ',') arg++ ;
+                }
+
+        return(1) ;
+        }
+
+/************************************
+ * bench_tx : EUSART hook, the exported records
+ ***********************************/
+static void     bench_tx(unsigned char b)
+        {
+        bench_txBytes++ ;
+        if(bench_export) fputc(b, bench_export) ;
+        }
+
+/************************************
+ * bench_analyse : video analysis of the recorded or loaded trace
+ * returns the number of failed checks
+ ***********************************/
+static int      bench_analyse()
+        {
+        unsigned char   decoded[BENCH_BYTES] ;
+        int             failed ;
+
+        failed = VIDEO_report(bench_jitter, bench_strict) ;
+
+        if(bench_traceOut && !VIDEO_save(bench_traceOut))
+                {
+                fprintf(stderr, "PAL_bench: can't write %s\n", bench_traceOut) ;
+                failed++ ;
+                }
+        if(bench_framePgm && !VIDEO_frame(bench_framePgm))
+                {
+                fprintf(stderr, "PAL_bench: no frame for %s\n", bench_framePgm) ;
+                failed++ ;
+                }
+
+        if(VIDEO_picture(decoded, BENCH_Y) != BENCH_Y)
+                {
+                printf("decoded picture has less than %d rows\n", BENCH_Y) ;
+                failed++ ;
+                }
+        else if(!bench_traceIn && memcmp(decoded, bench_shown, BENCH_BYTES))
+                {
+                printf("decoded picture differs from the scan-out\n") ;
+                failed++ ;
+                }
+        printf("\n") ;
+        bench_picture("video", decoded) ;
+
+        return(failed) ;
+        }
+
+/************************************
+ * bench_readouts : readouts of the last frame against the AN0 input,
+ * the frequency to the last digit, the peak to peak tension within two
+ * sample codes and the noise
+ * returns the number of failed checks
+ ***********************************/
+static int      bench_readouts()
+        {
+        const HAL_SIGNAL        *in ;
+        char            expected[FMT_SIZE] ;
+        unsigned char   n ;
+        double          hi, lo, vpp, tolerance ;
+        int             failed ;
+
+        in = &HAL_signal[0] ;
+        failed = 0 ;
+
+        n = FMT_eng(expected, (unsigned long)lround(in->freq * 1000), -3, 4, "Hz") ;
+        if(strncmp(frequency_display, expected, n) || ((frequency_display[n] != ' ') && (frequency_display[n] != 0)))
+                {
+                printf("%-12s %s differs from %s\n", "frequency", frequency_display, expected) ;
+                failed++ ;
+                }
+        else
+                {
+                printf("%-12s %s ok\n", "frequency", frequency_display) ;
+                }
+
+        /*
+         * extremes of the input in 8 bits codes, as the A/D clips them
+         */
+        hi = in->offset + ((in->wave == HAL_WAVE_DC) ? 0 : in->amplitude) ;
+        lo = in->offset - ((in->wave == HAL_WAVE_DC) ? 0 : in->amplitude) ;
+        hi = (hi > 1023) ? 1023 : (hi < 0) ? 0 : hi ;
+        lo = (lo > 1023) ? 1023 : (lo < 0) ? 0 : lo ;
+        vpp = (hi - lo) / 4 * MEAS_calibration[MEAS_range].span / 256 ;
+        tolerance = (2 + in->noise / 2) * MEAS_calibration[MEAS_range].span / 256 ;
+        if(fabs(MEAS_vpp - vpp) > tolerance)
+                {
+                printf("%-12s %s differs from %.0f mV\n", "tension", tension_display, vpp) ;
+                failed++ ;
+                }
+        else
+                {
+                printf("%-12s %s ok\n", "tension", tension_display) ;
+                }
+#ifdef PROF_LINE
+        printf("%-12s %s\n", "profile", profile_display) ;
+#endif
+
+        return(failed) ;
+        }
+
+/************************************
+ * bench_sequenceCheck : results of bench_sequence against the inputs
+ * returns the number of failed checks
+ ***********************************/
+static int      bench_sequenceCheck()
+        {
+        unsigned char   i, expected ;
+        int             failed, differs ;
+
+        failed = 0 ;
+        expected = (unsigned char)(HAL_input(bench_seq[0].channel, 0) >> 2) ;
+        if(bench_seqSingle != expected)
+                {
+                printf("%-12s AN%u %u differs from %u\n", "conversion", bench_seq[0].channel, bench_seqSingle, expected) ;
+                failed++ ;
+                }
+        else
+                {
+                printf("%-12s AN%u %u ok\n", "conversion", bench_seq[0].channel, bench_seqSingle) ;
+                }
+
+        if(!bench_seqDone)
+                {
+                printf("%-12s stalled, a conversion was taken by ACQ_ISR\n", "sequence") ;
+                return(failed + 1) ;
+                }
+        printf("%-12s", "sequence") ;
+        differs = 0 ;
+        for(i = 0 ; i < BENCH_SEQ ; i++)
+                {
+                expected = (unsigned char)(HAL_input(bench_seq[i].channel, 0) >> 2) ;
+                printf(" AN%u %u", bench_seq[i].channel, bench_seqResults[i]) ;
+                if(bench_seqResults[i] != expected)
+                        {
+                        printf(" differs from %u", expected) ;
+                        differs++ ;
+                        }
+                }
+        printf(differs ? "\n" : " ok\n") ;
+
+        return(failed + differs) ;
+        }
+
+static int      bench_run(unsigned long frames)
+        {
+        bench_clock::time_point t ;
+        double          s, cycles ;
+        int             failed ;
+        unsigned char   k ;
+        char            name[16] ;
+
+        if(bench_traceIn)
+                {
+                if(!VIDEO_load(bench_traceIn))
+                        {
+                        fprintf(stderr, "PAL_bench: can't read %s\n", bench_traceIn) ;
+                        return(1) ;
+                        }
+                return(bench_analyse()) ;
+                }
+
+        HAL_reset() ;
+        HAL_frameHook = bench_frame ;
+        HAL_lineHook = bench_scanLine ;
+        HAL_txHook = bench_tx ;
+        if(bench_video) HAL_pinHook = VIDEO_record ;
+        bench_frames = frames ;
+        bench_keyAt = 0 ;
+        bench_keyDown = 0 ;
+        bench_keyFrame = frames ;
+        bench_seqDone = 0 ;
+        memset(HAL_pins, 0, sizeof(HAL_pins)) ;
+        bench_txBytes = 0 ;
+
+        t = bench_clock::now() ;
+        try
+                {
+                HAL_firmwareMain() ;
+                }
+        catch(bench_stop &)
+                {
+                }
+        s = bench_seconds(t) ;
+        if(bench_export)
+                {
+                fclose(bench_export) ;
+                bench_export = 0 ;
+                }
+
+        frames = PAL_frameCtr ;
+        cycles = (double)HAL_cycles ;
+        printf("frames       %lu, %.0f cycles, %.3f s emulated\n", frames, cycles, cycles / HAL_FCY) ;
+        printf("host         %.3f ms per frame, %.1f x real time, interrupts %.3f ms per frame\n",
+                s * 1000 / frames, cycles / HAL_FCY / s, HAL_hostIsr * 1000 / frames) ;
+        printf("%-12s %12s %8s %12s\n", "level", "cycles/frame", "% frame", "calls/frame") ;
+        printf("%-12s %12.0f %8.1f %12s\n", "main + waits", HAL_busy[0] / (double)frames, HAL_busy[0] * 100 / cycles, "") ;
+        printf("%-12s %12.0f %8.1f %12.0f\n", "low", HAL_busy[1] / (double)frames, HAL_busy[1] * 100 / cycles, HAL_interrupts[1] / (double)frames) ;
+        printf("%-12s %12.0f %8.1f %12.0f\n", "high", HAL_busy[2] / (double)frames, HAL_busy[2] * 100 / cycles, HAL_interrupts[2] / (double)frames) ;
+        printf("%-12s %llu bytes, %.0f bytes/s\n", "export", bench_txBytes, bench_txBytes * HAL_FCY / cycles) ;
+        printf("\n") ;
+
+        failed = bench_readouts() ;
+        failed += bench_sequenceCheck() ;
+        bench_picture("firmware", bench_firmware) ;
+        for(k = 0 ; k < bench_keys ; k++)
+                {
+                sprintf(name, "key%u", k + 1) ;
+                bench_picture(name, bench_keyShown[k]) ;
+                }
+
+        if(bench_video) failed += bench_analyse() ;
+
+        return(failed) ;
+        }
+
+/************************************
+ * bench_signal : -s wave,freq,amp,offset[,noise]
+ ***********************************/
+static int      bench_signal(const char *arg)
+        {
+        static const char       *waves[] = { "dc", "sine", "square", "triangle", "saw" } ;
+        char            name[16] ;
+        HAL_SIGNAL      s ;
+        unsigned char   i ;
+        int             n ;
+
+        memset(&s, 0, sizeof(s)) ;
+        n = sscanf(arg, "%15[a-z],%lf,%lf,%lf,%lf", name, &s.freq, &s.amplitude, &s.offset, &s.noise) ;
+        if(n < 4) return(0) ;
+        for(i = 0 ; i < sizeof(waves) / sizeof(waves[0]) ; i++)
+                {
+                if(strcmp(name, waves[i]) == 0) break ;
+                }
+        if(i == sizeof(waves) / sizeof(waves[0])) return(0) ;
+        s.wave = i ;
+
+        HAL_signal[0] = s ;
+        return(1) ;
+        }
+#endif
+
+int     main(int argc, char **argv)
+        {
+        unsigned long   n ;
+        int             i ;
+
+#ifdef PAL_SCREEN
+        n = 100000 ;
+#else
+        n = 25 ;
+#endif
+        for(i = 1 ; i < argc ; i++)
+                {
+                if((strcmp(argv[i], "-w") == 0) && (i + 1 < argc))
+                        {
+                        bench_writeDir = argv[++i] ;
+                        }
+                else if((strcmp(argv[i], "-c") == 0) && (i + 1 < argc))
+                        {
+                        bench_goldenDir = argv[++i] ;
+                        }
+#ifdef PAL_SCREEN
+                else if((strcmp(argv[i], "-n") == 0) && (i + 1 < argc) && ((n = atol(argv[i + 1])) >= 100))
+                        {
+                        i++ ;
+                        }
+#else
+                else if((strcmp(argv[i], "-f") == 0) && (i + 1 < argc) && ((n = atol(argv[i + 1])) > 0))
+                        {
+                        i++ ;
+                        }
+                else if((strcmp(argv[i], "-s") == 0) && (i + 1 < argc) && bench_signal(argv[i + 1]))
+                        {
+                        i++ ;
+                        }
+                else if((strcmp(argv[i], "-k") == 0) && (i + 1 < argc) && bench_keyList(argv[i + 1]))
+                        {
+                        i++ ;
+                        }
+                else if(strcmp(argv[i], "-v") == 0)
+                        {
+                        bench_video = 1 ;
+                        }
+                else if((strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+                        {
+                        bench_jitter = atoi(argv[++i]) ;
+                        }
+                else if(strcmp(argv[i], "-S") == 0)
+                        {
+                        bench_strict = 1 ;
+                        }
+                else if((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+                        {
+                        bench_traceOut = argv[++i] ;
+                        bench_video = 1 ;
+                        }
+                else if((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+                        {
+                        bench_traceIn = argv[++i] ;
+                        }
+                else if((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+                        {
+                        bench_framePgm = argv[++i] ;
+                        bench_video = 1 ;
+                        }
+                else if((strcmp(argv[i], "-x") == 0) && (i + 1 < argc))
+                        {
+                        i++ ;
+                        bench_export = fopen(argv[i], "wb") ;
+                        if(!bench_export)
+                                {
+                                fprintf(stderr, "PAL_bench: can't write %s\n", argv[i]) ;
+                                return(1) ;
+                                }
+                        }
+#endif
+                else
+                        {
+#ifdef PAL_SCREEN
+                        fprintf(stderr, "usage: PAL_screen [-n calls] [-w dir] [-c dir]\n") ;
+#else
+                        fprintf(stderr, "usage: PAL_bench [-f frames] [-s wave,freq,amp,offset[,noise]] [-w dir] [-c dir]\n"
+                                "                 [-k key[,key...]] [-v] [-j cycles] [-S] [-o trace] [-t trace] [-p frame.pgm] [-x file]\n") ;
+#endif
+                        return(1) ;
+                        }
+                }
+
+        if(bench_run(n)) return(1) ;
+
+        return(bench_diffs ? 1 : 0) ;
+        }
@@ -0,0 +1,21 @@
+/*
+ * file         : PAL_host.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      PAL_library.c for the host build : the busy wait of PAL_vblankWait
+ *      runs the emulated chip, and ends each frame with HAL_frameHook
+ */
+
+#define PAL_vblankWait  PAL_vblankWaitTarget
+#include        "PAL_library.c"
+#undef  PAL_vblankWait
+
+void    PAL_vblankWait()
+        {
+        PAL_vblank = 0 ;
+        while(!PAL_vblank) HAL_idle() ;
+
+        if(HAL_frameHook) HAL_frameHook() ;
+        }
@@ -0,0 +1,470 @@
+/*
+ * file         : PAL_video.cpp
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      composite video analyser of the host bench
+ *      the input is the trace of the video pins : one record per write of
+ *      PORTD or PORTE, with its instruction cycle and the levels of
+ *      PAL_BVID (RD0) and PAL_BSYNC (RE0). It is recorded by HAL_pinHook on
+ *      the emulated chip, or loaded from a text file, one write per line :
+ *              <cycle> <video> <sync>
+ *      so that a PIC18 simulator trace can be checked as well.
+ *
+ *      the analyser rebuilds the lines from the sync pulses (a line starts
+ *      with a falling edge of PAL_BSYNC, a pulse half a line later is a
+ *      vertical sync half line), the fields from the broad pulses, and
+ *      measures against the 625 lines PAL standard :
+ *      - lines per frame and per field
+ *      - line period, horizontal sync, equalizing and broad pulse widths
+ *      - the picture : start of the first pixel after the line start,
+ *        width of each pixel, and jitter of each pixel position over all
+ *        picture lines
+ *      a picture line is 130 writes of PORTD after the end of its sync
+ *      pulse : left border, 128 pixels, right border.
+ *      the line period, the fields and the pixel jitter are always checked.
+ *      The pulse widths are checked in strict mode only : the emulated chip
+ *      counts one cycle per SFR access and none for the C code between two
+ *      accesses, so the pulses ended by C code (sync pulses timed by
+ *      TIMER 2) are a few cycles short of the real ones. Without strict,
+ *      they are shown for information.
+ *      the frame is rebuilt as a 625 x 512 image, one column per cycle,
+ *      and the last field is decoded back to the 128 pixels picture.
+ */
+
+#include        "PAL_video.h"
+
+#include        <cstdio>
+#include        <cstring>
+#include        <vector>
+
+#define VIDEO_FCY               8.0     // instruction cycles per us
+#define VIDEO_PIXELS            128     // pixels per picture line
+#define VIDEO_BROAD             128     // shortest broad pulse (cycles)
+
+#define VIDEO_LINE_PICTURE      0       // picture line
+#define VIDEO_LINE_BLANK        1       // one short sync pulse, no picture
+#define VIDEO_LINE_EQUAL        2       // two short pulses
+#define VIDEO_LINE_BROAD        3       // broad pulse first
+
+/*
+ * one write of the video pins
+ */
+typedef struct
+        {
+        unsigned long long      cycle ;
+        unsigned char           video ;
+        unsigned char           sync ;
+        } VIDEO_WRITE ;
+
+/*
+ * one line, from the falling edge of its first sync pulse
+ */
+typedef struct
+        {
+        unsigned long long      start ;         // falling edge of first pulse
+        unsigned int            width[2] ;      // pulse widths (cycles)
+        unsigned int            second ;        // second pulse, from start (cycles)
+        unsigned char           pulses ;        // number of pulses
+        unsigned int            first ;         // first write of the line
+        unsigned int            rise ;          // write that ends the first pulse
+        unsigned int            end ;           // first write of the next line
+        unsigned char           type ;          // VIDEO_LINE_*
+        } VIDEO_LINE ;
+
+/*
+ * min, max and mean of a measure
+ */
+typedef struct
+        {
+        double          min ;
+        double          max ;
+        double          sum ;
+        unsigned long   n ;
+        } VIDEO_STAT ;
+
+/***************
+ * RAM variables
+ ***************/
+static std::vector<VIDEO_WRITE> VIDEO_writes ;
+static std::vector<VIDEO_LINE>  VIDEO_lines ;
+static std::vector<unsigned int>        VIDEO_fields ;  // first line of each field (first broad line)
+static int              VIDEO_failed ;                  // checks out of tolerance
+
+/************************************
+ * VIDEO_add : add a value to a measure
+ ***********************************/
+static void     VIDEO_add(VIDEO_STAT *s, double v)
+        {
+        if((s->n == 0) || (v < s->min)) s->min = v ;
+        if((s->n == 0) || (v > s->max)) s->max = v ;
+        s->sum += v ;
+        s->n++ ;
+        }
+
+/************************************
+ * VIDEO_check : one line of the report, a measure against the standard
+ * tol 0 is for information only
+ ***********************************/
+static void     VIDEO_check(const char *name, const VIDEO_STAT *s, double spec, double tol, const char *unit)
+        {
+        const char      *status ;
+
+        if(s->n == 0)
+                {
+                printf("%-22s %10s\n", name, "none") ;
+                return ;
+                }
+        if(tol == 0)
+                {
+                status = "info" ;
+                }
+        else if((s->min < spec - tol) || (s->max > spec + tol))
+                {
+                status = "FAIL" ;
+                VIDEO_failed++ ;
+                }
+        else
+                {
+                status = "ok" ;
+                }
+        printf("%-22s %10.3f %10.3f %10.3f   %8.3f +/- %-6.3g %-3s %s\n",
+                name, s->min, s->sum / s->n, s->max, spec, tol, unit, status) ;
+        }
+
+/************************************
+ * VIDEO_parse : lines and fields from the trace
+ ***********************************/
+static void     VIDEO_parse()
+        {
+        VIDEO_LINE      l ;
+        unsigned char   sync, pulse ;
+        unsigned long long      fall ;
+        unsigned int    i ;
+
+        VIDEO_lines.clear() ;
+        VIDEO_fields.clear() ;
+
+        sync = 1 ;
+        pulse = 0 ;
+        fall = 0 ;
+        memset(&l, 0, sizeof(l)) ;
+        for(i = 0 ; i < VIDEO_writes.size() ; i++)
+                {
+                const VIDEO_WRITE       *w = &VIDEO_writes[i] ;
+
+                if(sync && !w->sync)                    // falling edge
+                        {
+                        fall = w->cycle ;
+                        if(!l.pulses || (fall - l.start > VIDEO_LINE_CYCLES * 3 / 4))
+                                {
+                                if(l.pulses)
+                                        {
+                                        l.end = i ;
+                                        VIDEO_lines.push_back(l) ;
+                                        }
+                                memset(&l, 0, sizeof(l)) ;
+                                l.start = fall ;
+                                l.first = i ;
+                                }
+                        else if(l.pulses == 1)
+                                {
+                                l.second = fall - l.start ;
+                                }
+                        pulse = l.pulses < 2 ;
+                        if(pulse) l.pulses++ ;
+                        }
+                else if(!sync && w->sync && pulse)      // rising edge
+                        {
+                        l.width[l.pulses - 1] = w->cycle - fall ;
+                        if(l.pulses == 1) l.rise = i ;
+                        pulse = 0 ;
+                        }
+                sync = w->sync ;
+                }
+
+        /*
+         * line types, a field starts with its first broad line, a half broad
+         * line (broad pulse in one half only) is a broad line. The first
+         * line of the trace does not start a field : its pulse may be cut.
+         */
+        for(i = 0 ; i < VIDEO_lines.size() ; i++)
+                {
+                VIDEO_LINE      *p = &VIDEO_lines[i] ;
+
+                if((p->width[0] >= VIDEO_BROAD) || (p->width[1] >= VIDEO_BROAD)) p->type = VIDEO_LINE_BROAD ;
+                else if(p->pulses == 2) p->type = VIDEO_LINE_EQUAL ;
+                else if(p->rise && (p->end - p->rise > VIDEO_PIXELS + 2)) p->type = VIDEO_LINE_PICTURE ;
+                else p->type = VIDEO_LINE_BLANK ;
+
+                if((p->type == VIDEO_LINE_BROAD) && i && (VIDEO_lines[i - 1].type != VIDEO_LINE_BROAD))
+                        {
+                        VIDEO_fields.push_back(i) ;
+                        }
+                }
+        }
+
+/************************************
+ * VIDEO_level : 8 bits luminance of the pins, 0.3 V black
+ ***********************************/
+static unsigned char    VIDEO_level(unsigned char video, unsigned char sync)
+        {
+        if(video) return(255) ;
+        if(sync) return(77) ;
+        return(0) ;
+        }
+
+/*********************
+ * ANALYSER
+ *********************/
+
+/************************************************************
+ * VIDEO_record : HAL_pinHook, records one write of the video pins
+ */
+void    VIDEO_record(unsigned long long cycle, unsigned char video, unsigned char sync)
+        {
+        VIDEO_WRITE     w ;
+
+        w.cycle = cycle ;
+        w.video = video ;
+        w.sync = sync ;
+        VIDEO_writes.push_back(w) ;
+        }
+
+/************************************************************
+ * VIDEO_load : read a trace file, returns 0 on error
+ */
+int     VIDEO_load(const char *file)
+        {
+        FILE            *f ;
+        unsigned long long      cycle ;
+        unsigned int    video, sync ;
+
+        f = fopen(file, "r") ;
+        if(!f) return(0) ;
+        VIDEO_writes.clear() ;
+        while(fscanf(f, "%llu %u %u", &cycle, &video, &sync) == 3) VIDEO_record(cycle, video & 1, sync & 1) ;
+        fclose(f) ;
+        return(1) ;
+        }
+
+/************************************************************
+ * VIDEO_save : write the trace, returns 0 on error
+ */
+int     VIDEO_save(const char *file)
+        {
+        FILE            *f ;
+        unsigned int    i ;
+
+        f = fopen(file, "w") ;
+        if(!f) return(0) ;
+        for(i = 0 ; i < VIDEO_writes.size() ; i++)
+                {
+                fprintf(f, "%llu %u %u\n", VIDEO_writes[i].cycle, VIDEO_writes[i].video, VIDEO_writes[i].sync) ;
+                }
+        fclose(f) ;
+        return(1) ;
+        }
+
+/************************************************************
+ * VIDEO_report : measure the trace against the PAL standard
+ * jitter is the largest allowed pixel jitter (cycles)
+ * strict checks the pulse widths too, for a simulator trace
+ * returns the number of checks out of tolerance
+ */
+int     VIDEO_report(unsigned int jitter, int strict)
+        {
+        VIDEO_STAT      period, hsync, blank, equal, broad, serration, field, frame ;
+        VIDEO_STAT      start, pixel, active, spread ;
+        std::vector<VIDEO_STAT> pos(VIDEO_PIXELS) ;
+        unsigned int    i, k, worst, from ;
+        double          pulses ;
+
+        VIDEO_parse() ;
+        VIDEO_failed = 0 ;
+
+        memset(&period, 0, sizeof(period)) ;
+        hsync = blank = equal = broad = serration = field = frame = period ;
+        start = pixel = active = spread = period ;
+
+        /*
+         * the lines before the first field are the start of the firmware
+         */
+        from = VIDEO_fields.empty() ? VIDEO_lines.size() : VIDEO_fields[0] ;
+        pulses = strict ? 1 : 0 ;
+
+        for(i = from + 1 ; i < VIDEO_lines.size() ; i++)
+                {
+                VIDEO_add(&period, (VIDEO_lines[i].start - VIDEO_lines[i - 1].start) / VIDEO_FCY) ;
+                }
+        for(i = from ; i < VIDEO_lines.size() ; i++)
+                {
+                const VIDEO_LINE        *l = &VIDEO_lines[i] ;
+
+                switch(l->type)
+                        {
+                        case VIDEO_LINE_PICTURE:
+                                VIDEO_add(&hsync, l->width[0] / VIDEO_FCY) ;
+                                /*
+                                 * writes after the pulse : left border, pixels, right border
+                                 */
+                                for(k = 0 ; k < VIDEO_PIXELS ; k++)
+                                        {
+                                        unsigned long long      t = VIDEO_writes[l->rise + 2 + k].cycle ;
+
+                                        VIDEO_add(&pos[k], (double)(t - l->start)) ;
+                                        VIDEO_add(&pixel, (double)(VIDEO_writes[l->rise + 3 + k].cycle - t)) ;
+                                        }
+                                VIDEO_add(&start, (VIDEO_writes[l->rise + 2].cycle - l->start) / VIDEO_FCY) ;
+                                VIDEO_add(&active, (VIDEO_writes[l->rise + 2 + VIDEO_PIXELS].cycle - VIDEO_writes[l->rise + 2].cycle) / VIDEO_FCY) ;
+                                break ;
+                        case VIDEO_LINE_BLANK:
+                                VIDEO_add(&blank, l->width[0] / VIDEO_FCY) ;
+                                break ;
+                        case VIDEO_LINE_EQUAL:
+                                VIDEO_add(&equal, l->width[0] / VIDEO_FCY) ;
+                                VIDEO_add(&equal, l->width[1] / VIDEO_FCY) ;
+                                break ;
+                        case VIDEO_LINE_BROAD:
+                                /*
+                                 * the serration is the gap after a broad pulse, up to the next pulse
+                                 */
+                                if(l->width[0] >= VIDEO_BROAD)
+                                        {
+                                        VIDEO_add(&broad, l->width[0] / VIDEO_FCY) ;
+                                        if((l->pulses == 2) && (l->second > l->width[0])) VIDEO_add(&serration, (l->second - l->width[0]) / VIDEO_FCY) ;
+                                        }
+                                else
+                                        {
+                                        VIDEO_add(&equal, l->width[0] / VIDEO_FCY) ;
+                                        }
+                                if(l->pulses < 2) break ;
+                                if(l->width[1] >= VIDEO_BROAD)
+                                        {
+                                        VIDEO_add(&broad, l->width[1] / VIDEO_FCY) ;
+                                        if((i + 1 < VIDEO_lines.size()) && (VIDEO_lines[i + 1].start > l->start + l->second + l->width[1]))
+                                                {
+                                                VIDEO_add(&serration, (VIDEO_lines[i + 1].start - l->start - l->second - l->width[1]) / VIDEO_FCY) ;
+                                                }
+                                        }
+                                else
+                                        {
+                                        VIDEO_add(&equal, l->width[1] / VIDEO_FCY) ;
+                                        }
+                                break ;
+                        }
+                }
+        for(i = 1 ; i < VIDEO_fields.size() ; i++)
+                {
+                VIDEO_add(&field, VIDEO_fields[i] - VIDEO_fields[i - 1]) ;
+                if(i >= 2) VIDEO_add(&frame, VIDEO_fields[i] - VIDEO_fields[i - 2]) ;
+                }
+
+        worst = 0 ;
+        for(k = 0 ; k < VIDEO_PIXELS ; k++)
+                {
+                if(pos[k].n == 0) continue ;
+                VIDEO_add(&spread, pos[k].max - pos[k].min) ;
+                if(pos[k].max - pos[k].min > pos[worst].max - pos[worst].min) worst = k ;
+                }
+
+        printf("%lu writes, %lu lines, %lu fields\n", (unsigned long)VIDEO_writes.size(),
+                (unsigned long)VIDEO_lines.size(), (unsigned long)(VIDEO_fields.size() ? VIDEO_fields.size() - 1 : 0)) ;
+        printf("%-22s %10s %10s %10s   %s\n", "measure", "min", "mean", "max", "PAL") ;
+        VIDEO_check("lines per frame", &frame, VIDEO_FRAME_LINES, 0.5, "") ;
+        VIDEO_check("lines per field", &field, 312.5, 0.5, "") ;
+        VIDEO_check("line period", &period, 64.0, 0.1, "us") ;
+        VIDEO_check("horizontal sync", &hsync, 4.7, 0.2 * pulses, "us") ;
+        VIDEO_check("blank line sync", &blank, 4.7, 0.2 * pulses, "us") ;
+        VIDEO_check("equalizing pulse", &equal, 2.35, 0.1 * pulses, "us") ;
+        VIDEO_check("broad pulse", &broad, 27.3, 0.2 * pulses, "us") ;
+        VIDEO_check("broad serration", &serration, 4.7, 0.2 * pulses, "us") ;
+        VIDEO_check("picture start", &start, 10.5, 0, "us") ;
+        VIDEO_check("picture width", &active, 52.0, 0, "us") ;
+        VIDEO_check("pixel width", &pixel, 2.5, 0, "cyc") ;
+        VIDEO_check("pixel jitter", &spread, 0, jitter + 0.001, "cyc") ;
+        if(spread.n && (spread.max > 0))
+                {
+                printf("%-22s pixel %u, %.0f to %.0f cycles from the line start\n", "worst pixel", worst, pos[worst].min, pos[worst].max) ;
+                }
+
+        if(VIDEO_lines.empty() || !frame.n || !hsync.n)
+                {
+                printf("no complete frame\n") ;
+                VIDEO_failed++ ;
+                }
+
+        return(VIDEO_failed) ;
+        }
+
+/************************************************************
+ * VIDEO_frame : last complete frame as a PGM image, one column per
+ * cycle, 0 is sync, 77 black, 255 white
+ * returns 0 on error
+ */
+int     VIDEO_frame(const char *file)
+        {
+        FILE            *f ;
+        unsigned int    first, n, i, c, w ;
+        unsigned char   level, line[VIDEO_LINE_CYCLES] ;
+
+        if(VIDEO_fields.size() < 3) return(0) ;
+        first = VIDEO_fields[VIDEO_fields.size() - 3] ;
+        n = VIDEO_fields[VIDEO_fields.size() - 1] - first ;
+
+        f = fopen(file, "wb") ;
+        if(!f) return(0) ;
+        fprintf(f, "P5\n%d %u\n255\n", VIDEO_LINE_CYCLES, n) ;
+        for(i = first ; i < first + n ; i++)
+                {
+                const VIDEO_LINE        *l = &VIDEO_lines[i] ;
+
+                w = l->first ;
+                level = VIDEO_level(VIDEO_writes[w].video, VIDEO_writes[w].sync) ;
+                for(c = 0 ; c < VIDEO_LINE_CYCLES ; c++)
+                        {
+                        while((w < VIDEO_writes.size()) && (VIDEO_writes[w].cycle <= l->start + c))
+                                {
+                                level = VIDEO_level(VIDEO_writes[w].video, VIDEO_writes[w].sync) ;
+                                w++ ;
+                                }
+                        line[c] = level ;
+                        }
+                fwrite(line, 1, sizeof(line), f) ;
+                }
+        fclose(f) ;
+        return(1) ;
+        }
+
+/************************************************************
+ * VIDEO_picture : decode the last complete field to a PAL_screen map,
+ * bit 0 of a byte is its leftmost pixel, each row is shown on two lines
+ * returns the number of rows found
+ */
+int     VIDEO_picture(unsigned char *screen, unsigned int rows)
+        {
+        unsigned int    i, k, row, first, last ;
+        unsigned char   *p ;
+
+        memset(screen, 0, rows * VIDEO_PIXELS / 8) ;
+        if(VIDEO_fields.size() < 2) return(0) ;
+        first = VIDEO_fields[VIDEO_fields.size() - 2] ;
+        last = VIDEO_fields[VIDEO_fields.size() - 1] ;
+
+        row = 0 ;
+        for(i = first ; (i < last) && (row < rows * 2) ; i++)
+                {
+                const VIDEO_LINE        *l = &VIDEO_lines[i] ;
+
+                if(l->type != VIDEO_LINE_PICTURE) continue ;
+                p = screen + (row >> 1) * (VIDEO_PIXELS / 8) ;  // the second line of a row is kept
+                memset(p, 0, VIDEO_PIXELS / 8) ;
+                for(k = 0 ; k < VIDEO_PIXELS ; k++)
+                        {
+                        if(VIDEO_writes[l->rise + 2 + k].video) p[k >> 3] |= 1 << (k & 7) ;
+                        }
+                row++ ;
+                }
+        return(row >> 1) ;
+        }
@@ -0,0 +1,23 @@
+/*
+ * file         : PAL_video.h
+ * project      : oscillo-pic18
+ * compiler     : any C++11 host compiler
+ *
+ * description  :
+ *      composite video analyser of the host bench, see PAL_video.cpp
+ */
+
+#ifndef PAL_VIDEO_H
+#define PAL_VIDEO_H
+
+#define VIDEO_LINE_CYCLES       512     // 64 us at 8 MHz
+#define VIDEO_FRAME_LINES       625
+
+void    VIDEO_record(unsigned long long cycle, unsigned char video, unsigned char sync) ;
+int     VIDEO_load(const char *file) ;
+int     VIDEO_save(const char *file) ;
+int     VIDEO_report(unsigned int jitter, int strict) ;
+int     VIDEO_frame(const char *file) ;
+int     VIDEO_picture(unsigned char *screen, unsigned int rows) ;
+
+#endif